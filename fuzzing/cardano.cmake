@@ -0,0 +1,172 @@
+# Sources, include directories and compile definitions shared by the host
+# builds of the app (fuzzing/ and native/).
+# Keep the feature flags in sync with the non-XS block of the main Makefile.
+
+set(SDK_PATH ${BOLOS_SDK})
+set(UX_PATH ${SDK_PATH}/lib_ux)
+set(CARDANO_PATH ${CMAKE_CURRENT_LIST_DIR}/..)
+
+set(UX_SOURCE
+    ${UX_PATH}/src/ux_flow_engine.c
+    ${UX_PATH}/src/ux_layout_bb.c
+    ${UX_PATH}/src/ux_layout_bn.c
+    ${UX_PATH}/src/ux_layout_bnn.c
+    ${UX_PATH}/src/ux_layout_bnnn.c
+    ${UX_PATH}/src/ux_layout_nn.c
+    ${UX_PATH}/src/ux_layout_paging.c
+    ${UX_PATH}/src/ux_layout_paging_compute.c
+    ${UX_PATH}/src/ux_layout_pbb.c
+    ${UX_PATH}/src/ux_layout_pb.c
+    ${UX_PATH}/src/ux_layout_pn.c
+    ${UX_PATH}/src/ux_layout_pnn.c
+    ${UX_PATH}/src/ux_layout_utils.c
+    ${UX_PATH}/src/ux_stack.c
+)
+
+set(CARDANO_SOURCE
+    ${CARDANO_PATH}/src/addressUtilsByron.c
+    ${CARDANO_PATH}/src/addressUtilsShelley.c
+    ${CARDANO_PATH}/src/app_mode.c
+    ${CARDANO_PATH}/src/assert.c
+    ${CARDANO_PATH}/src/auxDataHashBuilder.c
+    ${CARDANO_PATH}/src/base58.c
+    ${CARDANO_PATH}/src/bech32.c
+    ${CARDANO_PATH}/src/bip44.c
+    ${CARDANO_PATH}/src/cardano.c
+    ${CARDANO_PATH}/src/cbor.c
+    ${CARDANO_PATH}/src/crc32.c
+    ${CARDANO_PATH}/src/crypto.c
+    ${CARDANO_PATH}/src/deriveAddress.c
+    ${CARDANO_PATH}/src/deriveNativeScriptHash.c
+    ${CARDANO_PATH}/src/deriveNativeScriptHash_ui.c
+    ${CARDANO_PATH}/src/getPublicKeys.c
+    ${CARDANO_PATH}/src/getPublicKeys_ui.c
+    ${CARDANO_PATH}/src/getSerial.c
+    ${CARDANO_PATH}/src/getVersion.c
+    ${CARDANO_PATH}/src/handlers.c
+    ${CARDANO_PATH}/src/hash.c
+    ${CARDANO_PATH}/src/hexUtils.c
+    ${CARDANO_PATH}/src/io.c
+    ${CARDANO_PATH}/src/ipUtils.c
+    ${CARDANO_PATH}/src/keyDerivation.c
+    ${CARDANO_PATH}/src/keyHashCache.c
+    # ${CARDANO_PATH}/src/menu_nanos.c
+    ${CARDANO_PATH}/src/menu_nanox.c
+    ${CARDANO_PATH}/src/messageSigning.c
+    ${CARDANO_PATH}/src/nativeScriptHashBuilder.c
+    ${CARDANO_PATH}/src/perfCounters.c
+    ${CARDANO_PATH}/src/runTests.c
+    ${CARDANO_PATH}/src/securityPolicy.c
+    ${CARDANO_PATH}/src/signCVote.c
+    ${CARDANO_PATH}/src/signCVote_ui.c
+    ${CARDANO_PATH}/src/signMsg.c
+    ${CARDANO_PATH}/src/signMsg_ui.c
+    ${CARDANO_PATH}/src/signOpCert.c
+    ${CARDANO_PATH}/src/signTx.c
+    ${CARDANO_PATH}/src/signTxCVoteRegistration.c
+    ${CARDANO_PATH}/src/signTxCVoteRegistration_ui.c
+    ${CARDANO_PATH}/src/signTxMint.c
+    ${CARDANO_PATH}/src/signTxMint_ui.c
+    ${CARDANO_PATH}/src/signTxOutput.c
+    ${CARDANO_PATH}/src/signTxOutput_ui.c
+    ${CARDANO_PATH}/src/signTxPoolRegistration.c
+    ${CARDANO_PATH}/src/signTxPoolRegistration_ui.c
+    ${CARDANO_PATH}/src/signTxSession.c
+    ${CARDANO_PATH}/src/signTx_ui.c
+    ${CARDANO_PATH}/src/signTxUtils.c
+    ${CARDANO_PATH}/src/state.c
+    ${CARDANO_PATH}/src/textUtils.c
+    ${CARDANO_PATH}/src/tokens.c
+    ${CARDANO_PATH}/src/txHashBuilder.c
+    ${CARDANO_PATH}/src/uiHelpers.c
+    ${CARDANO_PATH}/src/uiHelpers_nanos.c
+    ${CARDANO_PATH}/src/uiHelpers_nanox.c
+    ${CARDANO_PATH}/src/ui_menu_nbgl.c
+    ${CARDANO_PATH}/src/ui_nbgl.c
+    ${CARDANO_PATH}/src/uiScreens_bagl.c
+    ${CARDANO_PATH}/src/uiScreens_nbgl.c
+    ${CARDANO_PATH}/src/votecastHashBuilder.c
+)
+
+# unit tests run by INS_RUN_TESTS, only needed by DEVEL builds
+set(CARDANO_TEST_SOURCE
+    ${CARDANO_PATH}/src/addressUtilsByron_test.c
+    ${CARDANO_PATH}/src/addressUtilsShelley_test.c
+    ${CARDANO_PATH}/src/auxDataHashBuilder_test.c
+    ${CARDANO_PATH}/src/base58_test.c
+    ${CARDANO_PATH}/src/bech32_test.c
+    ${CARDANO_PATH}/src/bip44_test.c
+    ${CARDANO_PATH}/src/cbor_test.c
+    ${CARDANO_PATH}/src/crc32_test.c
+    ${CARDANO_PATH}/src/endian_test.c
+    ${CARDANO_PATH}/src/hash_test.c
+    ${CARDANO_PATH}/src/ipUtils_test.c
+    ${CARDANO_PATH}/src/keyDerivation_test.c
+    ${CARDANO_PATH}/src/keyHashCache_test.c
+    ${CARDANO_PATH}/src/nativeScriptHashBuilder_test.c
+    ${CARDANO_PATH}/src/signTxSession_test.c
+    ${CARDANO_PATH}/src/state_test.c
+    ${CARDANO_PATH}/src/textUtils_test.c
+    ${CARDANO_PATH}/src/tokens_test.c
+)
+
+include_directories(
+    ${BOLOS_SDK}/include
+    ${BOLOS_SDK}/target/nanox/include
+    ${BOLOS_SDK}/lib_cxng/include
+    ${BOLOS_SDK}/lib_bagl/include
+    ${BOLOS_SDK}/lib_ux/include
+
+    ${CARDANO_PATH}/src
+    ${CMAKE_CURRENT_LIST_DIR}/include
+)
+
+add_compile_definitions(
+    FUZZING
+    HAVE_BAGL
+    BAGL_WIDTH=128
+    BAGL_HEIGHT=64
+    HAVE_UX_FLOW
+
+    MAJOR_VERSION=1
+    MINOR_VERSION=1
+    PATCH_VERSION=1
+    APPVERSION=\"1.1.1\"
+
+    IO_HID_EP_LENGTH=64
+    IO_SEPROXYHAL_BUFFER_SIZE_B=300
+    OS_IO_SEPROXYHAL
+
+    HAVE_ECC
+    HAVE_BLAKE2
+    HAVE_ECC_WEIERSTRASS
+    HAVE_SECP256K1_CURVE
+    HAVE_SECP256R1_CURVE
+    HAVE_ECC_TWISTED_EDWARDS
+    HAVE_ED25519_CURVE
+    HAVE_ECDSA
+    HAVE_EDDSA
+    HAVE_HASH
+    HAVE_SHA224
+    HAVE_SHA256
+    HAVE_SHA3
+
+    # include all app features, incl. those removed from Nano S
+    APP_FEATURE_OPCERT
+    APP_FEATURE_NATIVE_SCRIPT_HASH
+    APP_FEATURE_POOL_REGISTRATION
+    APP_FEATURE_POOL_RETIREMENT
+    APP_FEATURE_BYRON_ADDRESS_DERIVATION
+    APP_FEATURE_BYRON_PROTOCOL_MAGIC_CHECK
+    APP_FEATURE_ACCOUNT_NODE_CACHE
+    APP_FEATURE_KEY_HASH_CACHE
+    APP_FEATURE_CRC32_TABLE
+    APP_FEATURE_SIGN_TX_SESSION
+    APP_FEATURE_TOKEN_MINTING
+)
+
+# OS, UX and IO mocks shared by all host builds (crypto is mocked separately)
+set(MOCKS_SOURCE
+    ${CMAKE_CURRENT_LIST_DIR}/src/os_mocks.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/glyphs.c
+)
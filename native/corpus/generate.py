@@ -0,0 +1,460 @@
+# generates the APDU sessions of the native benchmark corpus
+#
+# usage: python3 generate.py [path/to/apdu_runner [path/to/apdu_runner_ui]]
+# with the runners, the responses are recorded into the sessions too;
+# the sessions in ui/ reject prompts and are recorded by apdu_runner_ui
+
+import hashlib
+import struct
+import subprocess
+import sys
+
+CLA = 0xD7
+HARDENED = 0x80000000
+
+INS_DERIVE_ADDRESS = 0x11
+INS_SIGN_TX = 0x21
+INS_SIGN_MSG = 0x24
+
+# see lookup_subhandler in src/signTx.c
+P1_INIT = 0x01
+P1_INPUTS = 0x02
+P1_OUTPUTS = 0x03
+P1_FEE = 0x04
+P1_TTL = 0x05
+P1_CERTIFICATES = 0x06
+P1_WITHDRAWALS = 0x07
+P1_AUX_DATA = 0x08
+P1_CONFIRM = 0x0a
+P1_MINT = 0x0b
+P1_REQUIRED_SIGNERS = 0x0e
+P1_WITNESSES = 0x0f
+
+NO = 1
+YES = 2
+
+SIGNING_MODE_ORDINARY = 3
+SIGNING_MODE_POOL_OWNER = 4
+SIGNING_MODE_PLUTUS = 7
+
+# see signTx.h
+P2_SINGLE = 0x00
+P2_BATCH = 0x01
+
+MAINNET_NETWORK_ID = 1
+MAINNET_PROTOCOL_MAGIC = 764824073
+
+def u1(x):
+	return struct.pack(">B", x)
+
+def u2(x):
+	return struct.pack(">H", x)
+
+def u4(x):
+	return struct.pack(">I", x)
+
+def u8(x):
+	return struct.pack(">Q", x)
+
+# deterministic "random" bytes
+def fakeBytes(label, size):
+	return hashlib.blake2b(label.encode(), digest_size=size).digest()
+
+def path(*indices):
+	return u1(len(indices)) + b"".join(u4(i) for i in indices)
+
+def paymentPath(account, address):
+	return path(1852 + HARDENED, 1815 + HARDENED, account + HARDENED, 0, address)
+
+def stakingPath(account):
+	return path(1852 + HARDENED, 1815 + HARDENED, account + HARDENED, 2, 0)
+
+def apdu(ins, p1, p2, data=b""):
+	assert len(data) <= 255
+	return bytes([CLA, ins, p1, p2, len(data)]) + data
+
+class Session:
+	def __init__(self, title):
+		self.lines = ["# " + title]
+
+	def comment(self, text):
+		self.lines.append("# " + text)
+
+	# with rejectPrompt, the user rejects the first prompt of the command (apdu_runner_ui only)
+	def add(self, ins, p1, p2, data=b"", rejectPrompt=False):
+		self.lines.append(("=! " if rejectPrompt else "=> ") + apdu(ins, p1, p2, data).hex())
+
+	def write(self, filename):
+		with open(filename, "w") as f:
+			f.write("\n".join(self.lines) + "\n")
+
+	# replays the commands and inserts the responses after them
+	def record(self, filename, runner):
+		trace = subprocess.run([runner, "-t", filename], check=True, capture_output=True, text=True).stdout
+		responses = iter(line for line in trace.splitlines() if line.startswith("<="))
+		recorded = []
+		for line in self.lines:
+			recorded.append(line)
+			if line.startswith("=>") or line.startswith("=!"):
+				recorded.append(next(responses))
+		self.lines = recorded
+		self.write(filename)
+
+# ============================== SIGN TX ==============================
+
+def txInit(
+	signingMode, numInputs, numOutputs, numCertificates=0, numWitnesses=1, includeAuxData=False,
+	numWithdrawals=0, numRequiredSigners=0, includeMint=False
+):
+	return (
+		u8(0) # tx options
+		+ u1(MAINNET_NETWORK_ID)
+		+ u4(MAINNET_PROTOCOL_MAGIC)
+		+ u1(YES) # ttl
+		+ u1(YES if includeAuxData else NO)
+		+ u1(NO) # validity interval start
+		+ u1(YES if includeMint else NO)
+		+ u1(NO) # script data hash
+		+ u1(NO) # network id
+		+ u1(NO) # collateral output
+		+ u1(NO) # total collateral
+		+ u1(NO) # treasury
+		+ u1(NO) # donation
+		+ u1(signingMode)
+		+ u4(numInputs)
+		+ u4(numOutputs)
+		+ u4(numCertificates)
+		+ u4(numWithdrawals)
+		+ u4(0) # collateral inputs
+		+ u4(numRequiredSigners)
+		+ u4(0) # reference inputs
+		+ u4(0) # voting procedures
+		+ u4(numWitnesses)
+	)
+
+def addInputs(s, count):
+	for i in range(count):
+		s.add(INS_SIGN_TX, P1_INPUTS, 0x00, fakeBytes(f"tx {i}", 32) + u4(i))
+
+def thirdPartyAddress(label):
+	# base address, key hash payment and staking parts, mainnet
+	return bytes([0x01]) + fakeBytes(label + " payment", 28) + fakeBytes(label + " staking", 28)
+
+def thirdPartyDestination(label):
+	address = thirdPartyAddress(label)
+	return u1(1) + u4(len(address)) + address
+
+def deviceOwnedDestination(account, address):
+	return (
+		u1(2)
+		+ u1(0x00) # BASE_PAYMENT_KEY_STAKE_KEY
+		+ u1(MAINNET_NETWORK_ID)
+		+ paymentPath(account, address)
+		+ u1(0x22) # STAKING_KEY_PATH
+		+ stakingPath(account)
+	)
+
+# asset groups and tokens must be sent in the canonical CBOR order
+def multiAsset(label, numGroups, numTokens):
+	policies = sorted(fakeBytes(f"{label} policy {g}", 28) for g in range(numGroups))
+	groups = []
+	for g, policy in enumerate(policies):
+		names = [f"Token{g:02}{t:03}".encode() for t in range(numTokens)]
+		names.sort(key=lambda name: (len(name), name))
+		groups.append((policy, [(name, 1000 * (t + 1)) for t, name in enumerate(names)]))
+	return groups
+
+# see PACKED_TOKENS_BUFFER_SIZE in cardano.h
+PACKED_TOKENS_BUFFER_SIZE = 160
+
+# packs the token records into as few APDUs as possible,
+# all records but the first one must fit into PACKED_TOKENS_BUFFER_SIZE
+def addPackedTokens(s, p1, records):
+	packs = []
+	for record in records:
+		if packs and sum(map(len, packs[-1][1:])) + len(record) <= PACKED_TOKENS_BUFFER_SIZE:
+			packs[-1].append(record)
+		else:
+			packs.append([record])
+	for pack in packs:
+		s.add(INS_SIGN_TX, p1, 0x39, u1(len(pack)) + b"".join(pack))
+
+def addOutput(s, destination, lovelace, groups, packed=False):
+	# MAP_BABBAGE format, no datum, no reference script
+	s.add(INS_SIGN_TX, P1_OUTPUTS, 0x30, u1(1) + destination + u8(lovelace) + u4(len(groups)) + u1(NO) + u1(NO))
+	for policy, tokens in groups:
+		s.add(INS_SIGN_TX, P1_OUTPUTS, 0x31, policy + u4(len(tokens)))
+		if packed:
+			addPackedTokens(s, P1_OUTPUTS, [u1(len(name)) + name + u8(amount) for name, amount in tokens])
+			continue
+		for name, amount in tokens:
+			s.add(INS_SIGN_TX, P1_OUTPUTS, 0x32, u4(len(name)) + name + u8(amount))
+	s.add(INS_SIGN_TX, P1_OUTPUTS, 0x33)
+
+def addMint(s, groups, packed=False):
+	s.add(INS_SIGN_TX, P1_MINT, 0x30, u4(len(groups)))
+	for policy, tokens in groups:
+		s.add(INS_SIGN_TX, P1_MINT, 0x31, policy + u4(len(tokens)))
+		if packed:
+			addPackedTokens(s, P1_MINT, [u1(len(name)) + name + struct.pack(">q", amount) for name, amount in tokens])
+			continue
+		for name, amount in tokens:
+			s.add(INS_SIGN_TX, P1_MINT, 0x32, u4(len(name)) + name + struct.pack(">q", amount))
+	s.add(INS_SIGN_TX, P1_MINT, 0x33)
+
+# the compact form for outputs without tokens, inline datum and reference script
+def addSimpleOutput(s, destination, lovelace, datumHash=None):
+	datum = u1(YES) + datumHash if datumHash else u1(NO)
+	s.add(INS_SIGN_TX, P1_OUTPUTS, 0x38, u1(1) + destination + u8(lovelace) + datum)
+
+def addFeeTtlConfirm(s):
+	s.add(INS_SIGN_TX, P1_FEE, 0x00, u8(1_234_567))
+	s.add(INS_SIGN_TX, P1_TTL, 0x00, u8(150_000_000))
+	s.add(INS_SIGN_TX, P1_CONFIRM, 0x00)
+
+def largeMultiAssetTx():
+	numInputs = 20
+	numOutputs = 8
+	s = Session(f"ordinary tx, {numInputs} inputs, {numOutputs} outputs with 5 asset groups of 10 tokens each")
+	s.add(INS_SIGN_TX, P1_INIT, 0x00, txInit(SIGNING_MODE_ORDINARY, numInputs, numOutputs, numWitnesses=4))
+	addInputs(s, numInputs)
+	for o in range(numOutputs - 1):
+		addOutput(s, thirdPartyDestination(f"recipient {o}"), 2_000_000 + o, multiAsset(f"output {o}", 5, 10))
+	s.comment("change")
+	addOutput(s, deviceOwnedDestination(0, 1), 50_000_000, multiAsset("change", 5, 10))
+	addFeeTtlConfirm(s)
+	for i in range(4):
+		s.add(INS_SIGN_TX, P1_WITNESSES, 0x00, paymentPath(0, i))
+	return s
+
+def exchangePayout():
+	numOutputs = 300
+	s = Session(f"ordinary tx paying out to {numOutputs - 1} recipients with change, simple outputs")
+	s.add(INS_SIGN_TX, P1_INIT, 0x00, txInit(SIGNING_MODE_ORDINARY, 10, numOutputs, numWitnesses=1))
+	addInputs(s, 10)
+	for o in range(numOutputs - 1):
+		addSimpleOutput(s, thirdPartyDestination(f"recipient {o}"), 2_000_000 + o)
+	s.comment("change")
+	addSimpleOutput(s, deviceOwnedDestination(0, 1), 50_000_000)
+	addFeeTtlConfirm(s)
+	s.add(INS_SIGN_TX, P1_WITNESSES, 0x00, paymentPath(0, 0))
+	return s
+
+# a simple output whose datum hash is shown (in expert mode) before the output is confirmed,
+# the UI steps are checked by apdu_runner_ui
+def simpleOutputWithDatumHash():
+	s = Session("ordinary tx, simple output to a third party with a datum hash, change")
+	s.add(INS_SIGN_TX, P1_INIT, 0x00, txInit(SIGNING_MODE_ORDINARY, 1, 2))
+	addInputs(s, 1)
+	addSimpleOutput(s, thirdPartyDestination("recipient"), 2_000_000, fakeBytes("datum", 32))
+	s.comment("change")
+	addSimpleOutput(s, deviceOwnedDestination(0, 1), 50_000_000)
+	addFeeTtlConfirm(s)
+	s.add(INS_SIGN_TX, P1_WITNESSES, 0x00, paymentPath(0, 0))
+	return s
+
+# a simple output to a script address without datum, warned about and confirmed by a prompt
+def simpleOutputMissingDatum():
+	s = Session("ordinary tx, simple output to a script address without datum, change")
+	# base address, script hash payment and key hash staking parts, mainnet
+	address = bytes([0x11]) + fakeBytes("script payment", 28) + fakeBytes("script staking", 28)
+	s.add(INS_SIGN_TX, P1_INIT, 0x00, txInit(SIGNING_MODE_ORDINARY, 1, 2))
+	addInputs(s, 1)
+	addSimpleOutput(s, u1(1) + u4(len(address)) + address, 2_000_000)
+	s.comment("change")
+	addSimpleOutput(s, deviceOwnedDestination(0, 1), 50_000_000)
+	addFeeTtlConfirm(s)
+	s.add(INS_SIGN_TX, P1_WITNESSES, 0x00, paymentPath(0, 0))
+	return s
+
+# the witnesses of a confirmed tx rejected by the user
+def rejectedWitness():
+	s = Session("ordinary tx, simple outputs, the witness rejected")
+	s.add(INS_SIGN_TX, P1_INIT, 0x00, txInit(SIGNING_MODE_ORDINARY, 1, 2))
+	addInputs(s, 1)
+	addSimpleOutput(s, thirdPartyDestination("recipient"), 2_000_000)
+	s.comment("change")
+	addSimpleOutput(s, deviceOwnedDestination(0, 1), 50_000_000)
+	addFeeTtlConfirm(s)
+	# an unusual address index, so that the witness is warned about and confirmed by a prompt
+	s.add(INS_SIGN_TX, P1_WITNESSES, 0x00, paymentPath(0, 2_000_000), rejectPrompt=True)
+	s.comment("the tx is over, the next instruction starts")
+	address = u1(0x00) + u1(MAINNET_NETWORK_ID) + paymentPath(0, 0) + u1(0x22) + stakingPath(0)
+	s.add(INS_DERIVE_ADDRESS, P1_RETURN, 0x00, address)
+	return s
+
+# an NFT collection minted and sent to a buyer
+def nftMint(packed=True):
+	numNfts = 100
+	s = Session(f"ordinary tx minting {numNfts} NFTs and sending them to a third party, packed tokens")
+	policy = fakeBytes("nft policy", 28)
+	names = sorted((f"Nft{t:04}".encode() for t in range(numNfts)), key=lambda name: (len(name), name))
+	s.add(INS_SIGN_TX, P1_INIT, 0x00, txInit(SIGNING_MODE_ORDINARY, 1, 2, includeMint=True))
+	addInputs(s, 1)
+	addOutput(s, thirdPartyDestination("buyer"), 20_000_000, [(policy, [(name, 1) for name in names])], packed)
+	s.comment("change")
+	addOutput(s, deviceOwnedDestination(0, 1), 50_000_000, multiAsset("change", 1, 30), packed)
+	s.add(INS_SIGN_TX, P1_FEE, 0x00, u8(1_234_567))
+	s.add(INS_SIGN_TX, P1_TTL, 0x00, u8(150_000_000))
+	addMint(s, [(policy, [(name, 1) for name in names])], packed)
+	s.add(INS_SIGN_TX, P1_CONFIRM, 0x00)
+	s.add(INS_SIGN_TX, P1_WITNESSES, 0x00, paymentPath(0, 0))
+	return s
+
+# see signTxPoolRegistration.h for the P2 codes
+def poolRegistrationWithManyOwnersAndRelays():
+	numOwners = 1000
+	numRelays = 1000
+	s = Session(f"pool registration signed by an owner, {numOwners} owners, {numRelays} relays")
+	s.add(INS_SIGN_TX, P1_INIT, 0x00, txInit(SIGNING_MODE_POOL_OWNER, 1, 1, numCertificates=1))
+	addInputs(s, 1)
+	addOutput(s, thirdPartyDestination("pool operator"), 10_000_000, [])
+	s.add(INS_SIGN_TX, P1_FEE, 0x00, u8(1_234_567))
+	s.add(INS_SIGN_TX, P1_TTL, 0x00, u8(150_000_000))
+
+	s.add(INS_SIGN_TX, P1_CERTIFICATES, 0x00, u1(3)) # CERTIFICATE_STAKE_POOL_REGISTRATION
+	s.add(INS_SIGN_TX, P1_CERTIFICATES, 0x30, u4(numOwners) + u4(numRelays))
+	s.add(INS_SIGN_TX, P1_CERTIFICATES, 0x31, u1(2) + fakeBytes("pool key", 28))
+	s.add(INS_SIGN_TX, P1_CERTIFICATES, 0x32, fakeBytes("vrf key", 32))
+	s.add(INS_SIGN_TX, P1_CERTIFICATES, 0x33, u8(500_000_000_000) + u8(340_000_000) + u8(3) + u8(100))
+	s.add(INS_SIGN_TX, P1_CERTIFICATES, 0x34, u1(2) + bytes([0xe1]) + fakeBytes("reward account", 28))
+	s.comment("owners, the device owns the first one")
+	s.add(INS_SIGN_TX, P1_CERTIFICATES, 0x35, u1(1) + stakingPath(0))
+	for o in range(1, numOwners):
+		s.add(INS_SIGN_TX, P1_CERTIFICATES, 0x35, u1(2) + fakeBytes(f"owner {o}", 28))
+	s.comment("relays")
+	for r in range(numRelays):
+		port = u1(YES) + u2(3000 + r % 100)
+		if r % 3 == 0:
+			ipv4 = u1(YES) + bytes([10, r >> 8, r & 0xff, 1])
+			ipv6 = u1(YES) + fakeBytes(f"ipv6 {r}", 16)
+			s.add(INS_SIGN_TX, P1_CERTIFICATES, 0x36, u1(0) + port + ipv4 + ipv6)
+		elif r % 3 == 1:
+			s.add(INS_SIGN_TX, P1_CERTIFICATES, 0x36, u1(1) + port + f"relay{r}.example.com".encode())
+		else:
+			s.add(INS_SIGN_TX, P1_CERTIFICATES, 0x36, u1(2) + f"relays{r}.example.com".encode())
+	s.add(INS_SIGN_TX, P1_CERTIFICATES, 0x37, u1(YES) + fakeBytes("metadata", 32) + b"https://example.com/pool.json")
+	s.add(INS_SIGN_TX, P1_CERTIFICATES, 0x38)
+
+	s.add(INS_SIGN_TX, P1_CONFIRM, 0x00)
+	s.add(INS_SIGN_TX, P1_WITNESSES, 0x00, stakingPath(0))
+	return s
+
+# see signTxCVoteRegistration.c for the P2 codes
+def cip36Registration():
+	s = Session("ordinary tx with a CIP-36 registration delegating to three vote keys")
+	s.add(INS_SIGN_TX, P1_INIT, 0x00, txInit(SIGNING_MODE_ORDINARY, 1, 1, numWitnesses=2, includeAuxData=True))
+	s.add(INS_SIGN_TX, P1_AUX_DATA, 0x00, u1(1)) # AUX_DATA_TYPE_CVOTE_REGISTRATION
+	s.add(INS_SIGN_TX, P1_AUX_DATA, 0x36, u1(2) + u4(3)) # CIP36, 3 delegations
+	s.add(INS_SIGN_TX, P1_AUX_DATA, 0x37, u1(1) + fakeBytes("vote key 0", 32) + u4(1))
+	s.add(INS_SIGN_TX, P1_AUX_DATA, 0x37, u1(1) + fakeBytes("vote key 1", 32) + u4(2))
+	s.add(INS_SIGN_TX, P1_AUX_DATA, 0x37, u1(2) + path(1694 + HARDENED, 1815 + HARDENED, HARDENED, 0, 0) + u4(3))
+	s.add(INS_SIGN_TX, P1_AUX_DATA, 0x31, stakingPath(0))
+	s.add(INS_SIGN_TX, P1_AUX_DATA, 0x32, deviceOwnedDestination(0, 0))
+	s.add(INS_SIGN_TX, P1_AUX_DATA, 0x33, u8(150_000_000))
+	s.add(INS_SIGN_TX, P1_AUX_DATA, 0x35, u1(YES) + u8(0))
+	s.add(INS_SIGN_TX, P1_AUX_DATA, 0x34)
+	addInputs(s, 1)
+	addOutput(s, deviceOwnedDestination(0, 1), 10_000_000, [])
+	addFeeTtlConfirm(s)
+	s.add(INS_SIGN_TX, P1_WITNESSES, 0x00, paymentPath(0, 0))
+	s.add(INS_SIGN_TX, P1_WITNESSES, 0x00, stakingPath(0))
+	return s
+
+# sends the items packed by batchSize, the rest one by one
+def addBatched(s, p1, items, batchSize):
+	numBatched = len(items) - len(items) % batchSize
+	for i in range(0, numBatched, batchSize):
+		s.add(INS_SIGN_TX, p1, P2_BATCH, u1(batchSize) + b"".join(items[i:i + batchSize]))
+	for item in items[numBatched:]:
+		s.add(INS_SIGN_TX, p1, P2_SINGLE, item)
+
+# see SIGN_TX_WITHDRAWAL_BATCH_MAX and SIGN_TX_REQUIRED_SIGNER_BATCH_MAX in signTx.h
+def rewardSweep():
+	numWithdrawals = 32
+	numRequiredSigners = 16
+	s = Session(f"Plutus tx sweeping {numWithdrawals} reward accounts, {numRequiredSigners} required signers, packed")
+	s.add(INS_SIGN_TX, P1_INIT, 0x00, txInit(
+		SIGNING_MODE_PLUTUS, 1, 1, numWitnesses=1,
+		numWithdrawals=numWithdrawals, numRequiredSigners=numRequiredSigners
+	))
+	addInputs(s, 1)
+	addOutput(s, deviceOwnedDestination(0, 0), 500_000_000, [])
+	s.add(INS_SIGN_TX, P1_FEE, 0x00, u8(1_234_567))
+	s.add(INS_SIGN_TX, P1_TTL, 0x00, u8(150_000_000))
+	# reward accounts must come in the canonical CBOR order, they share the header byte
+	stakeKeyHashes = sorted(fakeBytes(f"stake key {w}", 28) for w in range(numWithdrawals))
+	withdrawals = [u8(1_000_000 + w) + u1(2) + keyHash for w, keyHash in enumerate(stakeKeyHashes)]
+	addBatched(s, P1_WITHDRAWALS, withdrawals, 5)
+	requiredSigners = [u1(0) + paymentPath(0, r) for r in range(4)]
+	requiredSigners += [u1(1) + fakeBytes(f"signer {r}", 28) for r in range(4, numRequiredSigners)]
+	addBatched(s, P1_REQUIRED_SIGNERS, requiredSigners, 7)
+	s.add(INS_SIGN_TX, P1_CONFIRM, 0x00)
+	s.add(INS_SIGN_TX, P1_WITNESSES, 0x00, paymentPath(0, 0))
+	return s
+
+# ============================== DERIVE ADDRESS ==============================
+
+# see deriveAddress.c
+P1_RETURN = 0x01
+P1_RETURN_RANGE = 0x03
+P2_RANGE_INIT = 0x00
+P2_RANGE_NEXT = 0x01
+
+# the addresses are streamed in responses of at most this size, see deriveAddress.h
+RANGE_RESPONSE_SIZE = 240
+
+# a gap-limit window of a wallet, as rebuilt by a backend on every sync
+def addressRange():
+	count = 50
+	s = Session(f"{count} base addresses of an account returned by a single DERIVE_ADDRESS range request")
+	address = u1(0x00) + u1(MAINNET_NETWORK_ID) + paymentPath(0, 0) + u1(0x22) + stakingPath(0)
+	s.add(INS_DERIVE_ADDRESS, P1_RETURN_RANGE, P2_RANGE_INIT, address + u4(count))
+	# a base address takes 1 + 57 bytes of a response
+	perResponse = RANGE_RESPONSE_SIZE // 58
+	for _ in range(perResponse, count, perResponse):
+		s.add(INS_DERIVE_ADDRESS, P1_RETURN_RANGE, P2_RANGE_NEXT)
+	return s
+
+# ============================== SIGN MESSAGE ==============================
+
+# see signMsg.h for the chunk sizes
+def cip8Message():
+	message = b"".join(fakeBytes(f"message {i}", 64) for i in range(32))
+	s = Session(f"CIP-8 message, {len(message)} bytes, hashed, signed by a payment key")
+	address = u1(0x00) + u1(MAINNET_NETWORK_ID) + paymentPath(0, 0) + u1(0x22) + stakingPath(0)
+	init = u4(len(message)) + paymentPath(0, 0) + u1(1) + u1(0) + u1(1) + address
+	s.add(INS_SIGN_MSG, 0x01, 0x00, init)
+	chunks = [message[:99]]
+	chunks += [message[i:i + 250] for i in range(99, len(message), 250)]
+	for chunk in chunks:
+		s.add(INS_SIGN_MSG, 0x02, 0x00, u4(len(chunk)) + chunk)
+	s.add(INS_SIGN_MSG, 0x03, 0x00)
+	return s
+
+sessions = {
+	"signTxLargeMultiAsset.apdu": largeMultiAssetTx(),
+	"signTxExchangePayout.apdu": exchangePayout(),
+	"signTxPoolRegistration1000.apdu": poolRegistrationWithManyOwnersAndRelays(),
+	"signTxCip36Registration.apdu": cip36Registration(),
+	"signTxRewardSweep.apdu": rewardSweep(),
+	"signTxNftMint.apdu": nftMint(),
+	"signTxSimpleOutputDatumHash.apdu": simpleOutputWithDatumHash(),
+	"signTxSimpleOutputMissingDatum.apdu": simpleOutputMissingDatum(),
+	"signMsgCip8.apdu": cip8Message(),
+	"deriveAddressRange.apdu": addressRange(),
+}
+
+uiSessions = {
+	"ui/signTxRejectedWitness.apdu": rejectedWitness(),
+}
+
+for filename, session in sessions.items():
+	session.write(filename)
+	if len(sys.argv) > 1:
+		session.record(filename, sys.argv[1])
+
+for filename, session in uiSessions.items():
+	session.write(filename)
+	if len(sys.argv) > 2:
+		session.record(filename, sys.argv[2])
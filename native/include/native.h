@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// BIP39 mnemonic of the emulated device, "abandon x11 about" if not set
+#define NATIVE_MNEMONIC_ENV "NATIVE_MNEMONIC"
+
+// size of the last response APDU (data and status word) in G_io_apdu_buffer,
+// zero if nothing has been sent since it was reset
+extern size_t native_responseSize;
+
+// work done by the crypto backend, see native_crypto.c
+typedef struct {
+  uint64_t hashedBytes; // fed to cx_hash_no_throw (BLAKE2b, SHA3)
+  uint64_t derivations; // BIP32 derivations from the seed
+  uint64_t signatures;  // Ed25519 signatures
+} native_counters_t;
+
+extern native_counters_t native_counters;
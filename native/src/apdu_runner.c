@@ -0,0 +1,475 @@
+// Replays APDU sessions through the app handlers with real crypto and reports
+// the status words, the time spent and the crypto work done per instruction.
+//
+// Two session formats are accepted:
+//  - binary, the framing of the fuzzing corpus: a sequence of
+//    [ins, p1, p2, lc, data[lc]] records,
+//  - text traces (*.apdu), one APDU per line:
+//      # a comment
+//      => d721010000...   a command, the whole APDU including CLA and Lc
+//      <= 9000            the expected response (data and SW), optional
+//      =! d721...         a command whose first prompt the user rejects
+//    A line without a prefix is a command as well. Responses of the replayed
+//    commands are compared to the expected ones.
+//
+// The UI is flattened (FUZZING), so every prompt is confirmed automatically.
+// Built with NATIVE_STEPPED_UI (apdu_runner_ui), the UI steps are kept and
+// the runner confirms the displayed screens one by one, as a user would,
+// and can reject a prompt (only this build replays =! commands).
+
+#include <cx.h>
+#include <ctype.h>
+#include <os.h>
+#include <os_io.h>
+#include <sodium.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <ux.h>
+
+#include "native.h"
+
+#include "app_mode.h"
+#include "common.h"
+#include "errors.h"
+#include "handlers.h"
+#include "io.h"
+#include "state.h"
+#include "ui.h"
+#include "uiHelpers.h"
+
+uint8_t G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+#define APDU_HEADER_SIZE 5
+#define APDU_DATA_SIZE_MAX 255
+// see handlers.c
+#define CLA 0xD7
+
+#define SW_NO_RESPONSE 0
+
+#define STATE_POISON 0xa5
+
+#define TRACE_COMMAND_PREFIX "=>"
+#define TRACE_RESPONSE_PREFIX "<="
+#define TRACE_REJECTED_COMMAND_PREFIX "=!"
+
+typedef struct {
+  uint8_t header[APDU_HEADER_SIZE];
+  uint8_t data[APDU_DATA_SIZE_MAX];
+  bool rejectPrompt;
+  bool hasExpected;
+  uint8_t expected[IO_APDU_BUFFER_SIZE];
+  size_t expectedSize;
+  unsigned line; // in the trace, 0 for binary sessions
+} apdu_t;
+
+typedef struct {
+  apdu_t *apdus;
+  size_t numApdus;
+  size_t capacity;
+} session_t;
+
+typedef struct {
+  uint64_t apdus;
+  double ms;
+  native_counters_t counters;
+} ins_stats_t;
+
+static ins_stats_t stats[256];
+
+static void printHex(FILE *out, const char *prefix, const uint8_t *buf,
+                     size_t size) {
+  fprintf(out, "%s", prefix);
+  for (size_t i = 0; i < size; i++) {
+    fprintf(out, "%02x", buf[i]);
+  }
+  fprintf(out, "\n");
+}
+
+static double elapsedMs(const struct timespec *start,
+                        const struct timespec *end) {
+  return (double)(end->tv_sec - start->tv_sec) * 1e3 +
+         (double)(end->tv_nsec - start->tv_nsec) / 1e6;
+}
+
+#ifdef NATIVE_STEPPED_UI
+// the NBGL order of a rejection, see display_cancel_status in ui_nbgl.c
+static bool nbglReject = false;
+
+// confirms the displayed screens until the instruction responds
+// or no screen waits for a confirmation; with rejectPrompt,
+// the first prompt is rejected instead
+static void confirmScreens(bool rejectPrompt) {
+  while (native_responseSize == 0) {
+    ui_callback_t *callback;
+    switch (displayState.paginatedText.initMagic) {
+    case INIT_MAGIC_PAGINATED_TEXT:
+      callback = &displayState.paginatedText.callback;
+      break;
+    case INIT_MAGIC_PROMPT:
+      callback = &displayState.prompt.callback;
+      break;
+    default:
+      return;
+    }
+    if (callback->state != CALLBACK_NOT_RUN) {
+      return;
+    }
+    if (rejectPrompt &&
+        displayState.paginatedText.initMagic == INIT_MAGIC_PROMPT) {
+      if (nbglReject) {
+        // NBGL ends the instruction before the reject callback runs
+        ui_idle();
+      }
+      uiCallback_reject(callback);
+      return;
+    }
+    uiCallback_confirm(callback);
+  }
+}
+#endif
+
+// the dispatch of main.c, without the IO
+static uint16_t runApdu(const apdu_t *apdu) {
+  const uint8_t lc = apdu->header[4];
+
+  memcpy(G_io_apdu_buffer, apdu->header, APDU_HEADER_SIZE);
+  memcpy(G_io_apdu_buffer + APDU_HEADER_SIZE, apdu->data, lc);
+
+  native_responseSize = 0;
+  io_state = IO_EXPECT_NONE;
+
+  if (currentInstruction == INS_NONE) {
+    // handleApdu clears only the variant of the new instruction;
+    // the rest is poisoned rather than left zeroed by the previous
+    // instruction, so that a read of stale bytes changes the responses
+    memset(&instructionState, STATE_POISON, sizeof(instructionState));
+  }
+
+#ifdef NATIVE_STEPPED_UI
+  // the screens of the previous APDUs are gone
+  explicit_bzero(&displayState, sizeof(displayState));
+#endif
+
+  BEGIN_TRY {
+    TRY {
+      handleApdu(G_io_apdu_buffer, APDU_HEADER_SIZE + lc);
+#ifdef NATIVE_STEPPED_UI
+      confirmScreens(apdu->rejectPrompt);
+#endif
+    }
+    CATCH(ERR_ASSERT) {
+      // the device would not respond, start over with the next APDU
+      currentInstruction = INS_NONE;
+    }
+    CATCH_OTHER(e) {
+      if (e >= _ERR_AUTORESPOND_START && e < _ERR_AUTORESPOND_END) {
+        io_send_buf(e, NULL, 0);
+      }
+      ui_idle();
+    }
+    FINALLY {}
+  }
+  END_TRY;
+
+  if (native_responseSize < 2) {
+    native_responseSize = 0;
+    return SW_NO_RESPONSE;
+  }
+  return (uint16_t)((G_io_apdu_buffer[native_responseSize - 2] << 8) |
+                    G_io_apdu_buffer[native_responseSize - 1]);
+}
+
+static void addCounters(native_counters_t *acc, const native_counters_t *before,
+                        const native_counters_t *after) {
+  acc->hashedBytes += after->hashedBytes - before->hashedBytes;
+  acc->derivations += after->derivations - before->derivations;
+  acc->signatures += after->signatures - before->signatures;
+}
+
+// returns the number of responses differing from the expected ones,
+// which are only checked in the first run as they do not depend on the run;
+// *lastSw is the last status word
+static size_t runSession(const char *path, const session_t *session,
+                         bool firstRun, bool trace, uint16_t *lastSw) {
+  size_t numMismatches = 0;
+
+  // a fresh app
+  currentInstruction = INS_NONE;
+  *lastSw = SW_NO_RESPONSE;
+
+  for (size_t i = 0; i < session->numApdus; i++) {
+    const apdu_t *apdu = &session->apdus[i];
+    ins_stats_t *insStats = &stats[apdu->header[1]];
+
+    native_counters_t before = native_counters;
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    *lastSw = runApdu(apdu);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    insStats->apdus++;
+    insStats->ms += elapsedMs(&start, &end);
+    addCounters(&insStats->counters, &before, &native_counters);
+
+    if (trace) {
+      printHex(stdout, TRACE_COMMAND_PREFIX " ", apdu->header,
+               APDU_HEADER_SIZE + apdu->header[4]);
+      printHex(stdout, TRACE_RESPONSE_PREFIX " ", G_io_apdu_buffer,
+               native_responseSize);
+    }
+    if (firstRun && apdu->hasExpected &&
+        (apdu->expectedSize != native_responseSize ||
+         memcmp(apdu->expected, G_io_apdu_buffer, native_responseSize) != 0)) {
+      if (numMismatches == 0) {
+        fprintf(stderr, "%s:%u: unexpected response\n", path, apdu->line);
+        printHex(stderr, "  expected ", apdu->expected, apdu->expectedSize);
+        printHex(stderr, "  got      ", G_io_apdu_buffer, native_responseSize);
+      }
+      numMismatches++;
+    }
+  }
+  return numMismatches;
+}
+
+static apdu_t *appendApdu(session_t *session) {
+  if (session->numApdus == session->capacity) {
+    size_t capacity = (session->capacity == 0) ? 64 : 2 * session->capacity;
+    apdu_t *apdus = realloc(session->apdus, capacity * sizeof(apdu_t));
+    if (apdus == NULL) {
+      return NULL;
+    }
+    session->apdus = apdus;
+    session->capacity = capacity;
+  }
+  apdu_t *apdu = &session->apdus[session->numApdus++];
+  memset(apdu, 0, sizeof(*apdu));
+  return apdu;
+}
+
+static bool readBinarySession(FILE *f, session_t *session) {
+  uint8_t record[4];
+  while (fread(record, 1, sizeof(record), f) == sizeof(record)) {
+    apdu_t *apdu = appendApdu(session);
+    if (apdu == NULL) {
+      return false;
+    }
+    apdu->header[0] = CLA;
+    memcpy(apdu->header + 1, record, sizeof(record));
+    if (fread(apdu->data, 1, record[3], f) != record[3]) {
+      // a truncated record, as in some fuzzer inputs
+      session->numApdus--;
+      break;
+    }
+  }
+  return true;
+}
+
+// returns the number of bytes parsed, or -1 if the text is not hex
+static int parseHex(const char *text, uint8_t *out, size_t outSize) {
+  size_t size = 0;
+  while (*text != '\0') {
+    if (isspace((unsigned char)*text)) {
+      text++;
+      continue;
+    }
+    unsigned int byte;
+    if (size == outSize || !isxdigit((unsigned char)text[0]) ||
+        !isxdigit((unsigned char)text[1]) || sscanf(text, "%2x", &byte) != 1) {
+      return -1;
+    }
+    out[size++] = (uint8_t)byte;
+    text += 2;
+  }
+  return (int)size;
+}
+
+static bool readTraceSession(const char *path, FILE *f, session_t *session) {
+  char line[2 * (APDU_HEADER_SIZE + APDU_DATA_SIZE_MAX + 2) + 64];
+  unsigned lineNumber = 0;
+
+  while (fgets(line, sizeof(line), f) != NULL) {
+    lineNumber++;
+    if (strchr(line, '\n') == NULL && !feof(f)) {
+      fprintf(stderr, "%s:%u: line too long\n", path, lineNumber);
+      return false;
+    }
+
+    const char *text = line;
+    while (isspace((unsigned char)*text)) {
+      text++;
+    }
+    if (*text == '\0' || *text == '#') {
+      continue;
+    }
+
+    if (strncmp(text, TRACE_RESPONSE_PREFIX, 2) == 0) {
+      apdu_t *apdu =
+          (session->numApdus > 0) ? &session->apdus[session->numApdus - 1] : NULL;
+      if (apdu == NULL || apdu->hasExpected) {
+        fprintf(stderr, "%s:%u: response without a command\n", path,
+                lineNumber);
+        return false;
+      }
+      int size = parseHex(text + 2, apdu->expected, sizeof(apdu->expected));
+      if (size < 0) {
+        fprintf(stderr, "%s:%u: invalid response\n", path, lineNumber);
+        return false;
+      }
+      apdu->hasExpected = true;
+      apdu->expectedSize = (size_t)size;
+      continue;
+    }
+
+    bool rejectPrompt = false;
+    if (strncmp(text, TRACE_COMMAND_PREFIX, 2) == 0) {
+      text += 2;
+    } else if (strncmp(text, TRACE_REJECTED_COMMAND_PREFIX, 2) == 0) {
+#ifndef NATIVE_STEPPED_UI
+      fprintf(stderr, "%s:%u: a rejection needs apdu_runner_ui\n", path,
+              lineNumber);
+      return false;
+#endif
+      rejectPrompt = true;
+      text += 2;
+    }
+    uint8_t buffer[APDU_HEADER_SIZE + APDU_DATA_SIZE_MAX];
+    int size = parseHex(text, buffer, sizeof(buffer));
+    if (size < APDU_HEADER_SIZE || buffer[0] != CLA ||
+        size != APDU_HEADER_SIZE + buffer[4]) {
+      fprintf(stderr, "%s:%u: invalid command\n", path, lineNumber);
+      return false;
+    }
+    apdu_t *apdu = appendApdu(session);
+    if (apdu == NULL) {
+      return false;
+    }
+    memcpy(apdu->header, buffer, APDU_HEADER_SIZE);
+    memcpy(apdu->data, buffer + APDU_HEADER_SIZE, buffer[4]);
+    apdu->rejectPrompt = rejectPrompt;
+    apdu->line = lineNumber;
+  }
+  return true;
+}
+
+static bool isTrace(const char *path) {
+  const char *extension = strrchr(path, '.');
+  return extension != NULL && strcmp(extension, ".apdu") == 0;
+}
+
+static bool readSession(const char *path, session_t *session) {
+  memset(session, 0, sizeof(*session));
+
+  FILE *f = fopen(path, isTrace(path) ? "r" : "rb");
+  if (f == NULL) {
+    perror(path);
+    return false;
+  }
+  bool ok = isTrace(path) ? readTraceSession(path, f, session)
+                          : readBinarySession(f, session);
+  fclose(f);
+  return ok;
+}
+
+static void printStats(FILE *out, int repeats) {
+  fprintf(out, "  %-4s %8s %10s %12s %12s %12s\n", "INS", "APDUs", "ms",
+          "hashed B", "derivations", "signatures");
+  for (size_t ins = 0; ins < 256; ins++) {
+    const ins_stats_t *s = &stats[ins];
+    if (s->apdus == 0) {
+      continue;
+    }
+    fprintf(out, "  %02zx   %8llu %10.3f %12llu %12llu %12llu\n", ins,
+            (unsigned long long)(s->apdus / repeats), s->ms / repeats,
+            (unsigned long long)(s->counters.hashedBytes / repeats),
+            (unsigned long long)(s->counters.derivations / repeats),
+            (unsigned long long)(s->counters.signatures / repeats));
+  }
+}
+
+static void usage(const char *argv0) {
+  fprintf(stderr, "usage: %s [-t] [-s] [-x] [-g] [-n repeats] session...\n",
+          argv0);
+  fprintf(stderr, "  -t  print the replayed APDUs and responses as a trace\n");
+  fprintf(stderr, "  -s  print the per-instruction statistics\n");
+  fprintf(stderr, "  -x  run in expert mode\n");
+#ifdef NATIVE_STEPPED_UI
+  fprintf(stderr, "  -g  reject prompts in the order of NBGL\n");
+#endif
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  int repeats = 1;
+  bool tracing = false;
+  bool printStatistics = false;
+  int i = 1;
+  for (; i < argc && argv[i][0] == '-'; i++) {
+    if (strcmp(argv[i], "-t") == 0) {
+      tracing = true;
+    } else if (strcmp(argv[i], "-s") == 0) {
+      printStatistics = true;
+    } else if (strcmp(argv[i], "-x") == 0) {
+      app_mode_set_expert(1);
+#ifdef NATIVE_STEPPED_UI
+    } else if (strcmp(argv[i], "-g") == 0) {
+      nbglReject = true;
+#endif
+    } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      repeats = atoi(argv[++i]);
+    } else {
+      usage(argv[0]);
+    }
+  }
+  if (i == argc || repeats < 1) {
+    usage(argv[0]);
+  }
+  // the trace goes to stdout, so that it can be recorded
+  FILE *report = tracing ? stderr : stdout;
+
+  if (sodium_init() < 0) {
+    fprintf(stderr, "libsodium initialization failed\n");
+    return 1;
+  }
+  UX_INIT();
+
+  int result = 0;
+  for (; i < argc; i++) {
+    session_t session;
+    if (!readSession(argv[i], &session)) {
+      free(session.apdus);
+      result = 1;
+      continue;
+    }
+
+    memset(stats, 0, sizeof(stats));
+    size_t numMismatches = 0;
+    uint16_t lastSw = SW_NO_RESPONSE;
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int r = 0; r < repeats; r++) {
+      numMismatches +=
+          runSession(argv[i], &session, r == 0, tracing && r == 0, &lastSw);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    fprintf(report, "%s: %zu APDUs, last SW %04x, %.3f ms per run", argv[i],
+            session.numApdus, lastSw, elapsedMs(&start, &end) / repeats);
+    if (numMismatches > 0) {
+      fprintf(report, ", %zu unexpected responses", numMismatches);
+    }
+    fprintf(report, "\n");
+    if (printStatistics) {
+      printStats(report, repeats);
+    }
+
+    if (lastSw != SUCCESS || numMismatches > 0) {
+      result = 1;
+    }
+    free(session.apdus);
+  }
+  return result;
+}
@@ -0,0 +1,80 @@
+// Times base58_encode (32-bit limbs) against the previous byte-at-a-time
+// encoder (base58_encode_bytewise) on 80-byte inputs, the size of a Byron
+// address with a derivation path attribute.
+
+#include <os_io.h>
+#include <sodium.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common.h"
+#include "base58.h"
+
+#define ADDRESS_SIZE 80
+#define ADDRESSES 1000
+#define REPEATS 20
+
+// the app sources link against it, see apdu_runner.c
+uint8_t G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+static double elapsedMs(const struct timespec *start,
+                        const struct timespec *end) {
+  return (double)(end->tv_sec - start->tv_sec) * 1e3 +
+         (double)(end->tv_nsec - start->tv_nsec) / 1e6;
+}
+
+typedef size_t base58_encode_fn_t(const uint8_t *inBuffer, size_t inSize,
+                                  char *outStr, size_t outMaxSize);
+
+static double timeEncoder(base58_encode_fn_t *encode,
+                          uint8_t (*addresses)[ADDRESS_SIZE]) {
+  struct timespec start, end;
+  volatile size_t totalLength = 0;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int r = 0; r < REPEATS; r++) {
+    for (size_t i = 0; i < ADDRESSES; i++) {
+      char out[200];
+      totalLength += encode(addresses[i], ADDRESS_SIZE, out, sizeof(out));
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  return elapsedMs(&start, &end) * 1e3 / (ADDRESSES * REPEATS);
+}
+
+int main(void) {
+  if (sodium_init() < 0) {
+    fprintf(stderr, "libsodium initialization failed\n");
+    return 1;
+  }
+
+  uint8_t(*addresses)[ADDRESS_SIZE] = calloc(ADDRESSES, ADDRESS_SIZE);
+  randombytes_buf(addresses, ADDRESSES * ADDRESS_SIZE);
+
+  int result = 0;
+  for (size_t i = 0; i < ADDRESSES; i++) {
+    char expected[200], output[200];
+    base58_encode_bytewise(addresses[i], ADDRESS_SIZE, expected,
+                           sizeof(expected));
+    base58_encode(addresses[i], ADDRESS_SIZE, output, sizeof(output));
+    if (strcmp(expected, output) != 0) {
+      result = 1;
+    }
+  }
+
+  const double limbsUs = timeEncoder(base58_encode, addresses);
+  const double bytewiseUs = timeEncoder(base58_encode_bytewise, addresses);
+
+  printf("%d addresses of %d bytes\n", ADDRESSES, ADDRESS_SIZE);
+  printf("32-bit limbs:    %.3f us per address\n", limbsUs);
+  printf("byte at a time:  %.3f us per address\n", bytewiseUs);
+  if (result != 0) {
+    printf("outputs differ\n");
+  }
+
+  free(addresses);
+  return result;
+}
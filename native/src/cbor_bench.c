@@ -0,0 +1,211 @@
+// Times the appending of CBOR tokens to a buffered hash context, as done by
+// the hash builders (e.g. txHashBuilder), in tokens per second:
+//  - before: a header width chosen by a chain of comparisons, the token
+//    written into a scratch buffer and then copied into the hash buffer,
+//  - after: cbor_writeToken (a table lookup of the header width) writing
+//    straight into the hash buffer (_buffered_reserve and _buffered_commit).
+// Both are timed with and without the hashing itself.
+
+#include <os_io.h>
+#include <sodium.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common.h"
+#include "cbor.h"
+#include "endian.h"
+#include "hash.h"
+
+#define TOKENS 1000000
+#define REPEATS 10
+
+// the app sources link against it, see apdu_runner.c
+uint8_t G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+static double elapsedMs(const struct timespec *start,
+                        const struct timespec *end) {
+  return (double)(end->tv_sec - start->tv_sec) * 1e3 +
+         (double)(end->tv_nsec - start->tv_nsec) / 1e6;
+}
+
+// cbor_writeToken before the table lookup of the header width
+__attribute__((noipa)) static size_t
+writeTokenBranches(uint8_t type, uint64_t value, uint8_t *buffer,
+                                 size_t bufferSize) {
+  ASSERT(bufferSize < BUFFER_SIZE_PARANOIA);
+
+#define CHECK_BUF_LEN(requiredSize)                                            \
+  if ((size_t)requiredSize > bufferSize)                                       \
+    THROW(ERR_DATA_TOO_LARGE);
+  if (type == CBOR_TYPE_ARRAY_INDEF || type == CBOR_TYPE_INDEF_END ||
+      type == CBOR_TYPE_NULL) {
+    CHECK_BUF_LEN(1);
+    buffer[0] = type;
+    return 1;
+  }
+  if (type & CBOR_VALUE_MASK) {
+    THROW(ERR_UNEXPECTED_TOKEN);
+  }
+  switch (type) {
+  case CBOR_TYPE_NEGATIVE: {
+    int64_t negativeValue;
+    memmove(&negativeValue, &value, sizeof(value));
+    if (negativeValue >= 0) {
+      THROW(ERR_UNEXPECTED_TOKEN);
+    }
+    value = (uint64_t)(-negativeValue) - 1;
+  }
+    __attribute__((fallthrough));
+  case CBOR_TYPE_UNSIGNED:
+  case CBOR_TYPE_BYTES:
+  case CBOR_TYPE_TEXT:
+  case CBOR_TYPE_ARRAY:
+  case CBOR_TYPE_MAP:
+  case CBOR_TYPE_TAG:
+    break;
+  default:
+    THROW(ERR_UNEXPECTED_TOKEN);
+  }
+
+  if (value < 24) {
+    CHECK_BUF_LEN(1);
+    u1be_write(buffer, (uint8_t)(type | value));
+    return 1;
+  } else if (value < ((uint64_t)1 << 8)) {
+    CHECK_BUF_LEN(1 + 1);
+    u1be_write(buffer, type | 24);
+    u1be_write(buffer + 1, (uint8_t)value);
+    return 1 + 1;
+  } else if (value < ((uint64_t)1 << 16)) {
+    CHECK_BUF_LEN(1 + 2);
+    u1be_write(buffer, type | 25);
+    u2be_write(buffer + 1, (uint16_t)value);
+    return 1 + 2;
+  } else if (value < ((uint64_t)1 << 32)) {
+    CHECK_BUF_LEN(1 + 4);
+    u1be_write(buffer, type | 26);
+    u4be_write(buffer + 1, (uint32_t)value);
+    return 1 + 4;
+  } else {
+    CHECK_BUF_LEN(1 + 8);
+    u1be_write(buffer, type | 27);
+    u8be_write(buffer + 1, value);
+    return 1 + 8;
+  }
+#undef CHECK_BUF_LEN
+}
+
+// values of all header widths, in equal proportions
+static void makeValues(uint64_t *values, size_t count) {
+  uint64_t state = 0x9e3779b97f4a7c15;
+  for (size_t i = 0; i < count; i++) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    static const uint64_t limits[] = {24, (uint64_t)1 << 8, (uint64_t)1 << 16,
+                                      (uint64_t)1 << 32, UINT64_MAX};
+    values[i] = state % limits[i % ARRAY_LEN(limits)];
+  }
+}
+
+static double tokensPerSecond(double ms) {
+  return (double)TOKENS * REPEATS / (ms / 1e3);
+}
+
+int main(void) {
+  if (sodium_init() < 0) {
+    fprintf(stderr, "libsodium initialization failed\n");
+    return 1;
+  }
+
+  uint64_t *values = calloc(TOKENS, sizeof(uint64_t));
+  makeValues(values, TOKENS);
+
+  struct timespec start, end;
+  uint8_t hashBefore[BLAKE2B_256_SIZE] = {0};
+  uint8_t hashAfter[BLAKE2B_256_SIZE] = {0};
+  uint8_t sink[CBOR_TOKEN_SIZE_MAX * 64] = {0};
+  volatile uint8_t checksum = 0;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int r = 0; r < REPEATS; r++) {
+    size_t offset = 0;
+    for (size_t i = 0; i < TOKENS; i++) {
+      offset += writeTokenBranches(CBOR_TYPE_UNSIGNED, values[i], sink + offset,
+                                   sizeof(sink) - offset);
+      if (offset > sizeof(sink) - CBOR_TOKEN_SIZE_MAX) {
+        checksum ^= sink[offset - 1];
+        offset = 0;
+      }
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  const double encodeBeforeMs = elapsedMs(&start, &end);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int r = 0; r < REPEATS; r++) {
+    size_t offset = 0;
+    for (size_t i = 0; i < TOKENS; i++) {
+      offset += cbor_writeToken(CBOR_TYPE_UNSIGNED, values[i], sink + offset,
+                                sizeof(sink) - offset);
+      if (offset > sizeof(sink) - CBOR_TOKEN_SIZE_MAX) {
+        checksum ^= sink[offset - 1];
+        offset = 0;
+      }
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  const double encodeAfterMs = elapsedMs(&start, &end);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int r = 0; r < REPEATS; r++) {
+    blake2b_256_buffered_context_t ctx;
+    blake2b_256_buffered_init(&ctx);
+    for (size_t i = 0; i < TOKENS; i++) {
+      uint8_t buffer[10] = {0};
+      const size_t size =
+          writeTokenBranches(CBOR_TYPE_UNSIGNED, values[i], buffer,
+                             sizeof(buffer));
+      blake2b_256_buffered_append(&ctx, buffer, size);
+    }
+    blake2b_256_buffered_finalize(&ctx, hashBefore, sizeof(hashBefore));
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  const double hashBeforeMs = elapsedMs(&start, &end);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int r = 0; r < REPEATS; r++) {
+    blake2b_256_buffered_context_t ctx;
+    blake2b_256_buffered_init(&ctx);
+    for (size_t i = 0; i < TOKENS; i++) {
+      uint8_t scratch[CBOR_TOKEN_SIZE_MAX] = {0};
+      uint8_t *token =
+          blake2b_256_buffered_reserve(&ctx, scratch, sizeof(scratch));
+      const size_t size = cbor_writeToken(CBOR_TYPE_UNSIGNED, values[i], token,
+                                          sizeof(scratch));
+      blake2b_256_buffered_commit(&ctx, token, size);
+    }
+    blake2b_256_buffered_finalize(&ctx, hashAfter, sizeof(hashAfter));
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  const double hashAfterMs = elapsedMs(&start, &end);
+
+  printf("%d tokens of all header widths\n", TOKENS);
+  printf("encoding:            %.1f M tokens/s before, %.1f M tokens/s after\n",
+         tokensPerSecond(encodeBeforeMs) / 1e6,
+         tokensPerSecond(encodeAfterMs) / 1e6);
+  printf("encoding + hashing:  %.1f M tokens/s before, %.1f M tokens/s after\n",
+         tokensPerSecond(hashBeforeMs) / 1e6,
+         tokensPerSecond(hashAfterMs) / 1e6);
+
+  free(values);
+  if (memcmp(hashBefore, hashAfter, sizeof(hashBefore)) != 0) {
+    printf("hashes differ\n");
+    return 1;
+  }
+  return 0;
+}
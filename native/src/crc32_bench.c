@@ -0,0 +1,72 @@
+// Times crc32 (table-driven, APP_FEATURE_CRC32_TABLE) against the bitwise
+// crc32_bitwise kept for Nano S, in MB/s, on inputs of the size of a raw Byron
+// address with a derivation path attribute (the input of the address checksum).
+
+#include <os_io.h>
+#include <sodium.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common.h"
+#include "crc32.h"
+
+#define INPUT_SIZE 76
+#define INPUTS 1000
+#define REPEATS 200
+
+// the app sources link against it, see apdu_runner.c
+uint8_t G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+static double elapsedMs(const struct timespec *start,
+                        const struct timespec *end) {
+  return (double)(end->tv_sec - start->tv_sec) * 1e3 +
+         (double)(end->tv_nsec - start->tv_nsec) / 1e6;
+}
+
+typedef uint32_t crc32_fn_t(const uint8_t *inBuffer, size_t inSize);
+
+static double megabytesPerSecond(crc32_fn_t *crc,
+                                 uint8_t (*inputs)[INPUT_SIZE]) {
+  struct timespec start, end;
+  volatile uint32_t checksum = 0;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int r = 0; r < REPEATS; r++) {
+    for (size_t i = 0; i < INPUTS; i++) {
+      checksum ^= crc(inputs[i], INPUT_SIZE);
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  const double bytes = (double)INPUT_SIZE * INPUTS * REPEATS;
+  return bytes / 1e6 / (elapsedMs(&start, &end) / 1e3);
+}
+
+int main(void) {
+  if (sodium_init() < 0) {
+    fprintf(stderr, "libsodium initialization failed\n");
+    return 1;
+  }
+
+  uint8_t(*inputs)[INPUT_SIZE] = calloc(INPUTS, INPUT_SIZE);
+  randombytes_buf(inputs, INPUTS * INPUT_SIZE);
+
+  int result = 0;
+  for (size_t i = 0; i < INPUTS; i++) {
+    if (crc32(inputs[i], INPUT_SIZE) != crc32_bitwise(inputs[i], INPUT_SIZE)) {
+      result = 1;
+    }
+  }
+
+  printf("%d inputs of %d bytes\n", INPUTS, INPUT_SIZE);
+  printf("table:    %.1f MB/s\n", megabytesPerSecond(crc32, inputs));
+  printf("bitwise:  %.1f MB/s\n", megabytesPerSecond(crc32_bitwise, inputs));
+  if (result != 0) {
+    printf("checksums differ\n");
+  }
+
+  free(inputs);
+  return result;
+}
@@ -0,0 +1,622 @@
+// Real implementations of the cx_* / os_perso_* calls used by the app,
+// backed by libsodium (BLAKE2b, SHA-512, HMAC, Ed25519) and a small
+// Keccak-f[1600] for SHA3-256.
+//
+// The SDK context structs (cx_blake2b_t, cx_hmac_sha512_t, ...) are too small
+// for the libsodium states, so the states live in a pool keyed by the address
+// of the app's context. Re-initializing a context at the same address reuses
+// its slot, which is what happens with contexts kept in instructionState.
+//
+// Points in the "uncompressed" format (04 || x || y, big endian) are
+// represented by y and the parity of x only: the app reads nothing else
+// (see extractRawPublicKey in src/keyDerivation.c), and the conversion from
+// and to the compressed Ed25519 encoding needs nothing else either.
+
+#include <cx.h>
+#include <os.h>
+#include <sodium.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "native.h"
+
+#define ED25519_POINT_SIZE 32
+#define ED25519_UNCOMPRESSED_POINT_SIZE 65
+#define ED25519_SCALAR_SIZE 32
+
+native_counters_t native_counters;
+
+// ----- SHA3-256 -----
+
+#define KECCAK_ROUNDS 24
+#define SHA3_256_RATE 136
+
+typedef struct {
+  uint64_t st[25];
+  size_t pos;
+} keccak_state_t;
+
+static const uint64_t KECCAK_RC[KECCAK_ROUNDS] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL,
+    0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL,
+    0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
+    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
+    0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL,
+};
+
+static const int KECCAK_ROTC[24] = {1,  3,  6,  10, 15, 21, 28, 36,
+                                    45, 55, 2,  14, 27, 41, 56, 8,
+                                    25, 43, 62, 18, 39, 61, 20, 44};
+
+static const int KECCAK_PILN[24] = {10, 7,  11, 17, 18, 3,  5,  16,
+                                    8,  21, 24, 4,  15, 23, 19, 13,
+                                    12, 2,  20, 14, 22, 9,  6,  1};
+
+#define ROTL64(x, y) (((x) << (y)) | ((x) >> (64 - (y))))
+
+static void keccakf(uint64_t st[25]) {
+  for (int round = 0; round < KECCAK_ROUNDS; round++) {
+    uint64_t bc[5];
+    for (int i = 0; i < 5; i++) {
+      bc[i] = st[i] ^ st[i + 5] ^ st[i + 10] ^ st[i + 15] ^ st[i + 20];
+    }
+    for (int i = 0; i < 5; i++) {
+      uint64_t t = bc[(i + 4) % 5] ^ ROTL64(bc[(i + 1) % 5], 1);
+      for (int j = 0; j < 25; j += 5) {
+        st[j + i] ^= t;
+      }
+    }
+
+    uint64_t t = st[1];
+    for (int i = 0; i < 24; i++) {
+      int j = KECCAK_PILN[i];
+      uint64_t tmp = st[j];
+      st[j] = ROTL64(t, KECCAK_ROTC[i]);
+      t = tmp;
+    }
+
+    for (int j = 0; j < 25; j += 5) {
+      for (int i = 0; i < 5; i++) {
+        bc[i] = st[j + i];
+      }
+      for (int i = 0; i < 5; i++) {
+        st[j + i] ^= (~bc[(i + 1) % 5]) & bc[(i + 2) % 5];
+      }
+    }
+
+    st[0] ^= KECCAK_RC[round];
+  }
+}
+
+// the state is addressed as little endian bytes
+static void keccak_xorByte(keccak_state_t *ctx, size_t pos, uint8_t byte) {
+  ctx->st[pos / 8] ^= ((uint64_t)byte) << (8 * (pos % 8));
+}
+
+static void sha3_256_update(keccak_state_t *ctx, const uint8_t *in,
+                            size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    keccak_xorByte(ctx, ctx->pos++, in[i]);
+    if (ctx->pos == SHA3_256_RATE) {
+      keccakf(ctx->st);
+      ctx->pos = 0;
+    }
+  }
+}
+
+static void sha3_256_final(keccak_state_t *ctx, uint8_t out[32]) {
+  keccak_xorByte(ctx, ctx->pos, 0x06);
+  keccak_xorByte(ctx, SHA3_256_RATE - 1, 0x80);
+  keccakf(ctx->st);
+  for (size_t i = 0; i < 32; i++) {
+    out[i] = (uint8_t)(ctx->st[i / 8] >> (8 * (i % 8)));
+  }
+}
+
+// ----- hash state pool -----
+
+typedef enum {
+  HASH_KIND_BLAKE2B = 1,
+  HASH_KIND_SHA3 = 2,
+  HASH_KIND_HMAC_SHA512 = 3,
+} hash_kind_t;
+
+typedef struct {
+  const void *owner;
+  hash_kind_t kind;
+  size_t outputSize;
+  union {
+    crypto_generichash_state blake2b;
+    keccak_state_t sha3;
+    crypto_auth_hmacsha512_state hmac;
+  } state;
+} hash_slot_t;
+
+#define HASH_SLOT_COUNT 32
+
+static hash_slot_t hashSlots[HASH_SLOT_COUNT];
+static size_t nextEvictedSlot;
+
+static hash_slot_t *findSlot(const void *owner) {
+  for (size_t i = 0; i < HASH_SLOT_COUNT; i++) {
+    if (hashSlots[i].owner == owner) {
+      return &hashSlots[i];
+    }
+  }
+  return NULL;
+}
+
+static hash_slot_t *acquireSlot(const void *owner, hash_kind_t kind,
+                                size_t outputSize) {
+  hash_slot_t *slot = findSlot(owner);
+  if (slot == NULL) {
+    slot = findSlot(NULL);
+  }
+  if (slot == NULL) {
+    // contexts abandoned by an aborted instruction are never finalized
+    slot = &hashSlots[nextEvictedSlot];
+    nextEvictedSlot = (nextEvictedSlot + 1) % HASH_SLOT_COUNT;
+  }
+  memset(slot, 0, sizeof(*slot));
+  slot->owner = owner;
+  slot->kind = kind;
+  slot->outputSize = outputSize;
+  return slot;
+}
+
+static void releaseSlot(hash_slot_t *slot) {
+  sodium_memzero(slot, sizeof(*slot));
+}
+
+cx_err_t cx_blake2b_init_no_throw(cx_blake2b_t *hash, size_t size) {
+  size_t outputSize = size / 8;
+  if (size % 8 != 0 || outputSize < crypto_generichash_BYTES_MIN ||
+      outputSize > crypto_generichash_BYTES_MAX) {
+    return CX_INVALID_PARAMETER;
+  }
+  hash_slot_t *slot = acquireSlot(hash, HASH_KIND_BLAKE2B, outputSize);
+  crypto_generichash_init(&slot->state.blake2b, NULL, 0, outputSize);
+  return CX_OK;
+}
+
+cx_err_t cx_sha3_init_no_throw(cx_sha3_t *hash, size_t size) {
+  // the app only uses SHA3-256
+  if (size != 256) {
+    return CX_INVALID_PARAMETER;
+  }
+  acquireSlot(hash, HASH_KIND_SHA3, 32);
+  return CX_OK;
+}
+
+cx_err_t cx_hash_no_throw(cx_hash_t *hash, uint32_t mode, const uint8_t *in,
+                          size_t len, uint8_t *out, size_t out_len) {
+  hash_slot_t *slot = findSlot(hash);
+  if (slot == NULL) {
+    return CX_INVALID_PARAMETER;
+  }
+
+  native_counters.hashedBytes += len;
+
+  switch (slot->kind) {
+  case HASH_KIND_BLAKE2B:
+    crypto_generichash_update(&slot->state.blake2b, in, len);
+    break;
+  case HASH_KIND_SHA3:
+    sha3_256_update(&slot->state.sha3, in, len);
+    break;
+  default:
+    return CX_INVALID_PARAMETER;
+  }
+
+  if ((mode & CX_LAST) == 0) {
+    return CX_OK;
+  }
+  if (out == NULL || out_len < slot->outputSize) {
+    return CX_INVALID_PARAMETER;
+  }
+  if (slot->kind == HASH_KIND_BLAKE2B) {
+    crypto_generichash_final(&slot->state.blake2b, out, slot->outputSize);
+  } else {
+    sha3_256_final(&slot->state.sha3, out);
+  }
+  releaseSlot(slot);
+  return CX_OK;
+}
+
+size_t cx_hash_get_size(const cx_hash_t *ctx) {
+  hash_slot_t *slot = findSlot(ctx);
+  return (slot == NULL) ? 0 : slot->outputSize;
+}
+
+cx_err_t cx_hmac_sha512_init_no_throw(cx_hmac_sha512_t *hash,
+                                      const uint8_t *key, size_t key_len) {
+  hash_slot_t *slot = acquireSlot(hash, HASH_KIND_HMAC_SHA512,
+                                  crypto_auth_hmacsha512_BYTES);
+  crypto_auth_hmacsha512_init(&slot->state.hmac, key, key_len);
+  return CX_OK;
+}
+
+cx_err_t cx_hmac_update(cx_hmac_t *ctx, const uint8_t *data, size_t data_len) {
+  hash_slot_t *slot = findSlot(ctx);
+  if (slot == NULL || slot->kind != HASH_KIND_HMAC_SHA512) {
+    return CX_INVALID_PARAMETER;
+  }
+  crypto_auth_hmacsha512_update(&slot->state.hmac, data, data_len);
+  return CX_OK;
+}
+
+cx_err_t cx_hmac_final(cx_hmac_t *ctx, uint8_t *out, size_t *out_len) {
+  hash_slot_t *slot = findSlot(ctx);
+  if (slot == NULL || slot->kind != HASH_KIND_HMAC_SHA512) {
+    return CX_INVALID_PARAMETER;
+  }
+  if (*out_len < crypto_auth_hmacsha512_BYTES) {
+    return CX_INVALID_PARAMETER;
+  }
+  crypto_auth_hmacsha512_final(&slot->state.hmac, out);
+  *out_len = crypto_auth_hmacsha512_BYTES;
+  releaseSlot(slot);
+  return CX_OK;
+}
+
+// ----- Ed25519 -----
+
+static void compressPoint(const uint8_t W[ED25519_UNCOMPRESSED_POINT_SIZE],
+                          uint8_t out[ED25519_POINT_SIZE]) {
+  for (size_t i = 0; i < ED25519_POINT_SIZE; i++) {
+    out[i] = W[64 - i];
+  }
+  if ((W[32] & 1) != 0) {
+    out[31] |= 0x80;
+  }
+}
+
+static void uncompressPoint(const uint8_t in[ED25519_POINT_SIZE],
+                            uint8_t W[ED25519_UNCOMPRESSED_POINT_SIZE]) {
+  memset(W, 0, ED25519_UNCOMPRESSED_POINT_SIZE);
+  W[0] = 0x04;
+  // only the parity of x is kept, see the note at the top
+  W[32] = in[31] >> 7;
+  for (size_t i = 0; i < ED25519_POINT_SIZE; i++) {
+    W[64 - i] = in[i];
+  }
+  W[33] &= 0x7f;
+}
+
+// the same pruning as the SDK does for 64-byte (extended) private keys
+static void pruneScalar(const uint8_t *d, uint8_t scalar[ED25519_SCALAR_SIZE]) {
+  memcpy(scalar, d, ED25519_SCALAR_SIZE);
+  scalar[0] &= 0xf8;
+  scalar[31] = (scalar[31] & 0x7f) | 0x40;
+}
+
+static void reduceScalar(const uint8_t scalar[ED25519_SCALAR_SIZE],
+                         uint8_t out[ED25519_SCALAR_SIZE]) {
+  uint8_t wide[crypto_core_ed25519_NONREDUCEDSCALARBYTES] = {0};
+  memcpy(wide, scalar, ED25519_SCALAR_SIZE);
+  crypto_core_ed25519_scalar_reduce(out, wide);
+}
+
+cx_err_t cx_ecdomain_parameters_length(cx_curve_t cv, size_t *length) {
+  if (cv != CX_CURVE_Ed25519) {
+    return CX_EC_INVALID_CURVE;
+  }
+  *length = 32;
+  return CX_OK;
+}
+
+cx_err_t cx_eddsa_get_public_key_no_throw(const cx_ecfp_private_key_t *pv_key,
+                                          cx_md_t hashID,
+                                          cx_ecfp_public_key_t *pu_key,
+                                          uint8_t *a, size_t a_len, uint8_t *h,
+                                          size_t h_len) {
+  // the app only passes extended keys (kL || kR)
+  if (pv_key->curve != CX_CURVE_Ed25519 || pv_key->d_len != 64) {
+    return CX_INVALID_PARAMETER;
+  }
+  const uint8_t *d = pv_key->d;
+
+  uint8_t scalar[ED25519_SCALAR_SIZE];
+  uint8_t point[ED25519_POINT_SIZE];
+  pruneScalar(d, scalar);
+  if (crypto_scalarmult_ed25519_base_noclamp(point, scalar) != 0) {
+    return CX_INTERNAL_ERROR;
+  }
+  if (a != NULL && a_len >= ED25519_SCALAR_SIZE) {
+    memcpy(a, scalar, ED25519_SCALAR_SIZE);
+  }
+  if (h != NULL && h_len >= 32) {
+    memcpy(h, d + 32, 32);
+  }
+  sodium_memzero(scalar, sizeof(scalar));
+
+  pu_key->curve = CX_CURVE_Ed25519;
+  pu_key->W_len = ED25519_UNCOMPRESSED_POINT_SIZE;
+  uncompressPoint(point, pu_key->W);
+  return CX_OK;
+}
+
+cx_err_t cx_eddsa_sign_no_throw(const cx_ecfp_private_key_t *pvkey,
+                                cx_md_t hashID, const uint8_t *hash,
+                                size_t hash_len, uint8_t *sig, size_t sig_len) {
+  if (pvkey->curve != CX_CURVE_Ed25519 || pvkey->d_len != 64 ||
+      hashID != CX_SHA512 || sig_len < 64) {
+    return CX_INVALID_PARAMETER;
+  }
+  const uint8_t *d = pvkey->d;
+  native_counters.signatures++;
+
+  uint8_t scalar[ED25519_SCALAR_SIZE];
+  uint8_t reducedScalar[ED25519_SCALAR_SIZE];
+  uint8_t publicKey[ED25519_POINT_SIZE];
+  pruneScalar(d, scalar);
+  reduceScalar(scalar, reducedScalar);
+  if (crypto_scalarmult_ed25519_base_noclamp(publicKey, scalar) != 0) {
+    return CX_INTERNAL_ERROR;
+  }
+
+  uint8_t digest[crypto_hash_sha512_BYTES];
+  crypto_hash_sha512_state sha;
+
+  // r = H(kR || M)
+  uint8_t r[ED25519_SCALAR_SIZE];
+  crypto_hash_sha512_init(&sha);
+  crypto_hash_sha512_update(&sha, d + 32, 32);
+  crypto_hash_sha512_update(&sha, hash, hash_len);
+  crypto_hash_sha512_final(&sha, digest);
+  crypto_core_ed25519_scalar_reduce(r, digest);
+
+  // R = r * B
+  if (crypto_scalarmult_ed25519_base_noclamp(sig, r) != 0) {
+    return CX_INTERNAL_ERROR;
+  }
+
+  // S = r + H(R || A || M) * a
+  uint8_t k[ED25519_SCALAR_SIZE];
+  crypto_hash_sha512_init(&sha);
+  crypto_hash_sha512_update(&sha, sig, ED25519_POINT_SIZE);
+  crypto_hash_sha512_update(&sha, publicKey, sizeof(publicKey));
+  crypto_hash_sha512_update(&sha, hash, hash_len);
+  crypto_hash_sha512_final(&sha, digest);
+  crypto_core_ed25519_scalar_reduce(k, digest);
+
+  uint8_t ka[ED25519_SCALAR_SIZE];
+  crypto_core_ed25519_scalar_mul(ka, k, reducedScalar);
+  crypto_core_ed25519_scalar_add(sig + 32, r, ka);
+
+  sodium_memzero(scalar, sizeof(scalar));
+  sodium_memzero(reducedScalar, sizeof(reducedScalar));
+  sodium_memzero(r, sizeof(r));
+
+  return CX_OK;
+}
+
+// scalar is big endian, as everywhere in cx_ecfp_*
+cx_err_t cx_ecfp_scalar_mult_no_throw(cx_curve_t curve, uint8_t *P,
+                                      const uint8_t *k, size_t k_len) {
+  if (curve != CX_CURVE_Ed25519 || k_len > ED25519_SCALAR_SIZE) {
+    return CX_INVALID_PARAMETER;
+  }
+  uint8_t scalar[ED25519_SCALAR_SIZE] = {0};
+  for (size_t i = 0; i < k_len; i++) {
+    scalar[i] = k[k_len - 1 - i];
+  }
+
+  uint8_t point[ED25519_POINT_SIZE];
+  uint8_t result[ED25519_POINT_SIZE];
+  compressPoint(P, point);
+  if (crypto_scalarmult_ed25519_noclamp(result, scalar, point) != 0) {
+    return CX_EC_INVALID_POINT;
+  }
+  uncompressPoint(result, P);
+  return CX_OK;
+}
+
+cx_err_t cx_ecfp_add_point_no_throw(cx_curve_t curve, uint8_t *R,
+                                    const uint8_t *P, const uint8_t *Q) {
+  if (curve != CX_CURVE_Ed25519) {
+    return CX_INVALID_PARAMETER;
+  }
+  uint8_t p[ED25519_POINT_SIZE];
+  uint8_t q[ED25519_POINT_SIZE];
+  uint8_t r[ED25519_POINT_SIZE];
+  compressPoint(P, p);
+  compressPoint(Q, q);
+  if (crypto_core_ed25519_add(r, p, q) != 0) {
+    return CX_EC_INVALID_POINT;
+  }
+  uncompressPoint(r, R);
+  return CX_OK;
+}
+
+// ----- BIP32-Ed25519 key derivation -----
+
+// the default Speculos / test seed, the app's key derivation tests expect it
+#define DEFAULT_MNEMONIC                                                       \
+  "abandon abandon abandon abandon abandon abandon abandon abandon abandon "   \
+  "abandon abandon about"
+
+#define BIP39_SEED_SIZE 64
+#define BIP39_PBKDF2_ROUNDS 2048
+#define ED25519_SEED_KEY "ed25519 seed"
+#define HARDENED_INDEX 0x80000000u
+
+typedef struct {
+  uint8_t kL[32];
+  uint8_t kR[32];
+  uint8_t chainCode[32];
+} extended_node_t;
+
+static bool isMasterNodeValid;
+static extended_node_t masterNode;
+
+static void hmacSha512(const uint8_t *key, size_t keySize,
+                       const uint8_t *data1, size_t size1,
+                       const uint8_t *data2, size_t size2,
+                       uint8_t out[crypto_auth_hmacsha512_BYTES]) {
+  crypto_auth_hmacsha512_state st;
+  crypto_auth_hmacsha512_init(&st, key, keySize);
+  crypto_auth_hmacsha512_update(&st, data1, size1);
+  crypto_auth_hmacsha512_update(&st, data2, size2);
+  crypto_auth_hmacsha512_final(&st, out);
+}
+
+// BIP39 seed = PBKDF2-HMAC-SHA512(mnemonic, "mnemonic", 2048), no passphrase
+static void bip39MnemonicToSeed(const char *mnemonic,
+                                uint8_t seed[BIP39_SEED_SIZE]) {
+  const uint8_t salt[] = {'m', 'n', 'e', 'm', 'o', 'n', 'i', 'c', 0, 0, 0, 1};
+  const uint8_t *password = (const uint8_t *)mnemonic;
+  size_t passwordSize = strlen(mnemonic);
+
+  // a single PBKDF2 block since the output size equals the HMAC size
+  uint8_t u[crypto_auth_hmacsha512_BYTES];
+  hmacSha512(password, passwordSize, salt, sizeof(salt), NULL, 0, u);
+  memcpy(seed, u, BIP39_SEED_SIZE);
+  for (int round = 1; round < BIP39_PBKDF2_ROUNDS; round++) {
+    hmacSha512(password, passwordSize, u, sizeof(u), NULL, 0, u);
+    for (size_t i = 0; i < BIP39_SEED_SIZE; i++) {
+      seed[i] ^= u[i];
+    }
+  }
+  sodium_memzero(u, sizeof(u));
+}
+
+// Ledger's master node derivation, see "Ledger" in CIP-0003
+static void deriveMasterNode(const uint8_t *seed, size_t seedSize,
+                             extended_node_t *node) {
+  const uint8_t *key = (const uint8_t *)ED25519_SEED_KEY;
+  const size_t keySize = strlen(ED25519_SEED_KEY);
+
+  uint8_t i[crypto_auth_hmacsha512_BYTES];
+  hmacSha512(key, keySize, seed, seedSize, NULL, 0, i);
+  while ((i[31] & 0x20) != 0) {
+    hmacSha512(key, keySize, i, sizeof(i), NULL, 0, i);
+  }
+  memcpy(node->kL, i, 32);
+  memcpy(node->kR, i + 32, 32);
+  node->kL[0] &= 0xf8;
+  node->kL[31] &= 0x1f;
+  node->kL[31] |= 0x40;
+
+  const uint8_t prefix = 0x01;
+  crypto_auth_hmacsha256_state st;
+  crypto_auth_hmacsha256_init(&st, key, keySize);
+  crypto_auth_hmacsha256_update(&st, &prefix, 1);
+  crypto_auth_hmacsha256_update(&st, seed, seedSize);
+  crypto_auth_hmacsha256_final(&st, node->chainCode);
+
+  sodium_memzero(i, sizeof(i));
+}
+
+static const extended_node_t *getMasterNode(void) {
+  if (!isMasterNodeValid) {
+    const char *mnemonic = getenv(NATIVE_MNEMONIC_ENV);
+    if (mnemonic == NULL) {
+      mnemonic = DEFAULT_MNEMONIC;
+    }
+    uint8_t seed[BIP39_SEED_SIZE];
+    bip39MnemonicToSeed(mnemonic, seed);
+    deriveMasterNode(seed, sizeof(seed), &masterNode);
+    sodium_memzero(seed, sizeof(seed));
+    isMasterNodeValid = true;
+  }
+  return &masterNode;
+}
+
+// BIP32-Ed25519 (V2) private child derivation
+static int deriveChildNode(const extended_node_t *parent, uint32_t index,
+                           extended_node_t *child) {
+  const uint8_t indexLE[4] = {(uint8_t)index, (uint8_t)(index >> 8),
+                              (uint8_t)(index >> 16), (uint8_t)(index >> 24)};
+
+  uint8_t data[1 + 64 + 4];
+  size_t dataSize;
+  if (index >= HARDENED_INDEX) {
+    memcpy(data + 1, parent->kL, 32);
+    memcpy(data + 33, parent->kR, 32);
+    memcpy(data + 65, indexLE, 4);
+    dataSize = 1 + 64 + 4;
+  } else {
+    if (crypto_scalarmult_ed25519_base_noclamp(data + 1, parent->kL) != 0) {
+      return -1;
+    }
+    memcpy(data + 33, indexLE, 4);
+    dataSize = 1 + 32 + 4;
+  }
+  const bool hardened = index >= HARDENED_INDEX;
+
+  uint8_t z[crypto_auth_hmacsha512_BYTES];
+  uint8_t c[crypto_auth_hmacsha512_BYTES];
+  data[0] = hardened ? 0x00 : 0x02;
+  hmacSha512(parent->chainCode, 32, data, dataSize, NULL, 0, z);
+  data[0] = hardened ? 0x01 : 0x03;
+  hmacSha512(parent->chainCode, 32, data, dataSize, NULL, 0, c);
+
+  // kL' = 8 * ZL[0:28] + kL, kR' = ZR + kR (mod 2^256), all little endian
+  unsigned int carry = 0;
+  for (size_t i = 0; i < 32; i++) {
+    unsigned int zl8 = 0;
+    if (i < 28) {
+      zl8 = (unsigned int)z[i] << 3;
+    }
+    if (i > 0 && i <= 28) {
+      zl8 |= z[i - 1] >> 5;
+    }
+    carry += parent->kL[i] + (zl8 & 0xff);
+    child->kL[i] = (uint8_t)carry;
+    carry >>= 8;
+  }
+  carry = 0;
+  for (size_t i = 0; i < 32; i++) {
+    carry += parent->kR[i] + z[32 + i];
+    child->kR[i] = (uint8_t)carry;
+    carry >>= 8;
+  }
+  memcpy(child->chainCode, c + 32, 32);
+
+  sodium_memzero(z, sizeof(z));
+  sodium_memzero(data, sizeof(data));
+  return 0;
+}
+
+// cx_rng_no_throw from the SDK ends up here
+void cx_trng_get_random_data(uint8_t *buf, size_t size) {
+  randombytes_buf(buf, size);
+}
+
+// os_derive_bip32_no_throw from the SDK ends up here
+void os_perso_derive_node_with_seed_key(
+    unsigned int mode, cx_curve_t curve, const unsigned int *path,
+    unsigned int pathLength, unsigned char *privateKey, unsigned char *chain,
+    unsigned char *seed_key, unsigned int seed_key_length) {
+  if (curve != CX_CURVE_Ed25519 || seed_key != NULL) {
+    THROW(EXCEPTION);
+  }
+  native_counters.derivations++;
+
+  extended_node_t node = *getMasterNode();
+  for (unsigned int i = 0; i < pathLength; i++) {
+    extended_node_t child;
+    int error = deriveChildNode(&node, path[i], &child);
+    node = child;
+    sodium_memzero(&child, sizeof(child));
+    if (error != 0) {
+      sodium_memzero(&node, sizeof(node));
+      THROW(EXCEPTION);
+    }
+  }
+
+  if (privateKey != NULL) {
+    memcpy(privateKey, node.kL, 32);
+    memcpy(privateKey + 32, node.kR, 32);
+  }
+  if (chain != NULL) {
+    memcpy(chain, node.chainCode, 32);
+  }
+  sodium_memzero(&node, sizeof(node));
+}
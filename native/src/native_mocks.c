@@ -0,0 +1,17 @@
+#include <os.h>
+#include <stddef.h>
+#include <ux.h>
+
+#include "native.h"
+
+size_t native_responseSize;
+
+unsigned short io_exchange(unsigned char chan, unsigned short tx_len) {
+  native_responseSize = tx_len;
+  return 0;
+}
+
+void io_seproxyhal_display_default(const bagl_element_t *bagl) {}
+
+// checked by TRACE_STACK_USAGE in DEVEL builds, see APP_STACK_CANARY_MAGIC
+unsigned int app_stack_canary = 0xDEAD0031;
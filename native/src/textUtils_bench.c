@@ -0,0 +1,86 @@
+// Times str_formatDecimalAmount (digits written straight into the output,
+// two at a time) against the previous implementation formatting into a
+// reversed scratch buffer (str_formatDecimalAmount_reversed), on random ADA
+// amounts in lovelace (6 decimal places).
+
+#include <os_io.h>
+#include <sodium.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common.h"
+#include "cardano.h"
+#include "textUtils.h"
+
+#define AMOUNTS 100000
+#define REPEATS 20
+#define PLACES 6
+
+// the app sources link against it, see apdu_runner.c
+uint8_t G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+static double elapsedMs(const struct timespec *start,
+                        const struct timespec *end) {
+  return (double)(end->tv_sec - start->tv_sec) * 1e3 +
+         (double)(end->tv_nsec - start->tv_nsec) / 1e6;
+}
+
+typedef size_t format_fn_t(uint64_t amount, size_t places, char *out,
+                           size_t outSize);
+
+static double nsPerAmount(format_fn_t *format, const uint64_t *amounts) {
+  struct timespec start, end;
+  volatile size_t totalLength = 0;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int r = 0; r < REPEATS; r++) {
+    for (size_t i = 0; i < AMOUNTS; i++) {
+      char out[40];
+      totalLength += format(amounts[i], PLACES, out, sizeof(out));
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  return elapsedMs(&start, &end) * 1e6 / ((double)AMOUNTS * REPEATS);
+}
+
+int main(void) {
+  if (sodium_init() < 0) {
+    fprintf(stderr, "libsodium initialization failed\n");
+    return 1;
+  }
+
+  uint64_t *amounts = calloc(AMOUNTS, sizeof(uint64_t));
+  randombytes_buf(amounts, AMOUNTS * sizeof(uint64_t));
+  for (size_t i = 0; i < AMOUNTS; i++) {
+    amounts[i] %= LOVELACE_MAX_SUPPLY + 1;
+  }
+
+  int result = 0;
+  for (size_t i = 0; i < AMOUNTS; i++) {
+    char expected[40], output[40];
+    str_formatDecimalAmount_reversed(amounts[i], PLACES, expected,
+                                     sizeof(expected));
+    str_formatDecimalAmount(amounts[i], PLACES, output, sizeof(output));
+    if (strcmp(expected, output) != 0) {
+      result = 1;
+    }
+  }
+
+  const double directNs = nsPerAmount(str_formatDecimalAmount, amounts);
+  const double reversedNs =
+      nsPerAmount(str_formatDecimalAmount_reversed, amounts);
+
+  printf("%d amounts up to %llu lovelace\n", AMOUNTS,
+         (unsigned long long)LOVELACE_MAX_SUPPLY);
+  printf("direct:    %.1f ns per amount\n", directNs);
+  printf("reversed:  %.1f ns per amount\n", reversedNs);
+  if (result != 0) {
+    printf("outputs differ\n");
+  }
+
+  free(amounts);
+  return result;
+}
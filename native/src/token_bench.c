@@ -0,0 +1,124 @@
+// Times the token registry lookup (tokenInfos_find in src/tokens.c) on a
+// synthetic registry, by default with 10000 entries, against the linear scan
+// it replaced. Half of the looked up fingerprints are in the registry.
+//
+// The fingerprints are BLAKE2b-160 hashes, as in tokenRegistry/convert.py,
+// so they are spread evenly over the key space like the real ones.
+
+#include <os_io.h>
+#include <sodium.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common.h"
+#include "tokens.h"
+
+#define LOOKUPS 100000
+
+// the app sources link against it, see apdu_runner.c
+uint8_t G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+static double elapsedMs(const struct timespec *start,
+                        const struct timespec *end) {
+  return (double)(end->tv_sec - start->tv_sec) * 1e3 +
+         (double)(end->tv_nsec - start->tv_nsec) / 1e6;
+}
+
+static void makeFingerprint(uint32_t seed, uint8_t *fingerprint) {
+  uint8_t input[4];
+  memcpy(input, &seed, sizeof(input));
+  crypto_generichash(fingerprint, ASSET_FINGERPRINT_SIZE, input, sizeof(input),
+                     NULL, 0);
+}
+
+static int compareInfos(const void *a, const void *b) {
+  return memcmp(((const token_info_t *)a)->fingerprint,
+                ((const token_info_t *)b)->fingerprint,
+                ASSET_FINGERPRINT_SIZE);
+}
+
+// the lookup before the registry was sorted
+static const token_info_t *findLinear(const token_info_t *infos,
+                                      size_t infosCount,
+                                      const uint8_t *fingerprint) {
+  for (size_t i = 0; i < infosCount; i++) {
+    if (!memcmp(infos[i].fingerprint, fingerprint, ASSET_FINGERPRINT_SIZE)) {
+      return &infos[i];
+    }
+  }
+  return NULL;
+}
+
+int main(int argc, char **argv) {
+  size_t infosCount = 10000;
+  if (argc > 1) {
+    infosCount = (size_t)atol(argv[1]);
+  }
+  if (argc > 2 || infosCount == 0) {
+    fprintf(stderr, "usage: %s [registry size]\n", argv[0]);
+    return 2;
+  }
+  if (sodium_init() < 0) {
+    fprintf(stderr, "libsodium initialization failed\n");
+    return 1;
+  }
+
+  token_info_t *infos = calloc(infosCount, sizeof(token_info_t));
+  for (size_t i = 0; i < infosCount; i++) {
+    makeFingerprint((uint32_t)i, infos[i].fingerprint);
+    infos[i].ticker = "T";
+  }
+  qsort(infos, infosCount, sizeof(token_info_t), compareInfos);
+
+  // even lookups hit an entry, odd ones miss
+  uint8_t(*queries)[ASSET_FINGERPRINT_SIZE] =
+      calloc(LOOKUPS, ASSET_FINGERPRINT_SIZE);
+  for (size_t i = 0; i < LOOKUPS; i++) {
+    const uint32_t seed = (uint32_t)((i / 2) % infosCount);
+    makeFingerprint((i % 2 == 0) ? seed : (uint32_t)infosCount + seed,
+                    queries[i]);
+  }
+
+  int result = 0;
+  size_t found = 0;
+  struct timespec start, end;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (size_t i = 0; i < LOOKUPS; i++) {
+    const token_info_t *info = tokenInfos_find(infos, infosCount, queries[i],
+                                               ASSET_FINGERPRINT_SIZE);
+    found += (info != NULL);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  const double binaryMs = elapsedMs(&start, &end);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (size_t i = 0; i < LOOKUPS; i++) {
+    const token_info_t *info = findLinear(infos, infosCount, queries[i]);
+    if (info != tokenInfos_find(infos, infosCount, queries[i],
+                                ASSET_FINGERPRINT_SIZE)) {
+      result = 1;
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  const double linearMs = elapsedMs(&start, &end);
+
+  if (found != LOOKUPS / 2) {
+    result = 1;
+  }
+
+  printf("%zu entries, %d lookups (%zu found)\n", infosCount, LOOKUPS, found);
+  printf("binary search: %.3f us per lookup\n", binaryMs * 1e3 / LOOKUPS);
+  printf("linear scan:   %.3f us per lookup\n", linearMs * 1e3 / LOOKUPS);
+  if (result != 0) {
+    printf("lookups differ\n");
+  }
+
+  free(queries);
+  free(infos);
+  return result;
+}
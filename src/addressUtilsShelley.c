@@ -160,12 +160,16 @@ staking_data_source_t determineStakingChoice(address_type_t addressType)
 }
 
 __noinline_due_to_stack__
-static size_t view_appendAddressPublicKeyHash(write_view_t* view, const bip44_path_t* keyDerivationPath)
+static size_t view_appendAddressPublicKeyHash(
+        write_view_t* view,
+        const bip44_path_t* keyDerivationPath,
+        key_hash_fn_t* keyHashFn
+)
 {
 	TRACE_STACK_USAGE();
 
 	uint8_t hashedPubKey[ADDRESS_KEY_HASH_LENGTH] = {0};
-	bip44_pathToKeyHash(keyDerivationPath, hashedPubKey, SIZEOF(hashedPubKey));
+	keyHashFn(keyDerivationPath, hashedPubKey, SIZEOF(hashedPubKey));
 
 	view_appendBuffer(view, hashedPubKey, SIZEOF(hashedPubKey));
 
@@ -185,7 +189,11 @@ static bool _isBaseAddress(address_type_t addressType)
 	}
 }
 
-static size_t deriveAddress_base(const addressParams_t* addressParams, uint8_t* outBuffer, size_t outSize)
+static size_t deriveAddress_base(
+        const addressParams_t* addressParams,
+        key_hash_fn_t* keyHashFn,
+        uint8_t* outBuffer, size_t outSize
+)
 {
 	ASSERT(_isBaseAddress(addressParams->type));
 	ASSERT(outSize < BUFFER_SIZE_PARANOIA);
@@ -204,7 +212,7 @@ static size_t deriveAddress_base(const addressParams_t* addressParams, uint8_t*
 	switch (addressParams->type) {
 	case BASE_PAYMENT_KEY_STAKE_KEY:
 	case BASE_PAYMENT_KEY_STAKE_SCRIPT: {
-		view_appendAddressPublicKeyHash(&out, &addressParams->paymentKeyPath);
+		view_appendAddressPublicKeyHash(&out, &addressParams->paymentKeyPath, keyHashFn);
 		size += ADDRESS_KEY_HASH_LENGTH;
 	}
 	break;
@@ -222,7 +230,7 @@ static size_t deriveAddress_base(const addressParams_t* addressParams, uint8_t*
 	STATIC_ASSERT(SIZEOF(addressParams->stakingScriptHash) == SCRIPT_HASH_LENGTH, "bad stake script hash size");
 	switch (addressParams->stakingDataSource) {
 	case STAKING_KEY_PATH: {
-		view_appendAddressPublicKeyHash(&out, &addressParams->stakingKeyPath);
+		view_appendAddressPublicKeyHash(&out, &addressParams->stakingKeyPath, keyHashFn);
 		size += ADDRESS_KEY_HASH_LENGTH;
 	}
 	break;
@@ -281,6 +289,7 @@ static size_t view_appendVariableLengthUInt(write_view_t* view, uint64_t value)
 
 static size_t deriveAddress_pointer(
         const addressParams_t* addressParams,
+        key_hash_fn_t* keyHashFn,
         uint8_t* outBuffer, size_t outSize
 )
 {
@@ -296,7 +305,7 @@ static size_t deriveAddress_pointer(
 	}
 	{
 		if (addressType == POINTER_KEY) {
-			view_appendAddressPublicKeyHash(&out, &addressParams->paymentKeyPath);
+			view_appendAddressPublicKeyHash(&out, &addressParams->paymentKeyPath, keyHashFn);
 		} else {
 			view_appendBuffer(&out, addressParams->paymentScriptHash, SCRIPT_HASH_LENGTH);
 		}
@@ -317,6 +326,7 @@ static size_t deriveAddress_pointer(
 
 static size_t deriveAddress_enterprise(
         const addressParams_t* addressParams,
+        key_hash_fn_t* keyHashFn,
         uint8_t* outBuffer, size_t outSize
 )
 {
@@ -332,7 +342,7 @@ static size_t deriveAddress_enterprise(
 	}
 	{
 		if (addressType == ENTERPRISE_KEY) {
-			view_appendAddressPublicKeyHash(&out, &addressParams->paymentKeyPath);
+			view_appendAddressPublicKeyHash(&out, &addressParams->paymentKeyPath, keyHashFn);
 		} else {
 			view_appendBuffer(&out, addressParams->paymentScriptHash, SCRIPT_HASH_LENGTH);
 		}
@@ -350,6 +360,7 @@ static size_t deriveAddress_enterprise(
 
 static size_t deriveAddress_reward(
         const addressParams_t* addressParams,
+        key_hash_fn_t* keyHashFn,
         uint8_t* outBuffer, size_t outSize
 )
 {
@@ -374,7 +385,7 @@ static size_t deriveAddress_reward(
 			BIP44_PRINTF(stakingKeyPath);
 			PRINTF("\n");
 			ASSERT(bip44_isOrdinaryStakingKeyPath(stakingKeyPath));
-			view_appendAddressPublicKeyHash(&out, stakingKeyPath);
+			view_appendAddressPublicKeyHash(&out, stakingKeyPath, keyHashFn);
 		} else {
 			view_appendBuffer(&out, addressParams->stakingScriptHash, SCRIPT_HASH_LENGTH);
 		}
@@ -403,6 +414,7 @@ size_t constructRewardAddressFromKeyPath(
 	addressParamsStub.stakingKeyPath = *path;
 	return deriveAddress_reward(
 	               &addressParamsStub,
+	               bip44_pathToKeyHash,
 	               outBuffer, outSize
 	       );
 }
@@ -435,6 +447,15 @@ size_t constructRewardAddressFromHash(
 }
 
 size_t deriveAddress(const addressParams_t* addressParams, uint8_t* outBuffer, size_t outSize)
+{
+	return deriveAddressWithKeyHashFn(addressParams, bip44_pathToKeyHash, outBuffer, outSize);
+}
+
+size_t deriveAddressWithKeyHashFn(
+        const addressParams_t* addressParams,
+        key_hash_fn_t* keyHashFn,
+        uint8_t* outBuffer, size_t outSize
+)
 {
 	ASSERT(outSize < BUFFER_SIZE_PARANOIA);
 	ASSERT(isValidAddressParams(addressParams));
@@ -445,17 +466,17 @@ size_t deriveAddress(const addressParams_t* addressParams, uint8_t* outBuffer, s
 	case BASE_PAYMENT_SCRIPT_STAKE_KEY:
 	case BASE_PAYMENT_KEY_STAKE_SCRIPT:
 	case BASE_PAYMENT_SCRIPT_STAKE_SCRIPT:
-		return deriveAddress_base(addressParams, outBuffer, outSize);
+		return deriveAddress_base(addressParams, keyHashFn, outBuffer, outSize);
 	case POINTER_KEY:
 	case POINTER_SCRIPT:
 		ASSERT(addressParams->stakingDataSource == BLOCKCHAIN_POINTER);
-		return deriveAddress_pointer(addressParams, outBuffer, outSize);
+		return deriveAddress_pointer(addressParams, keyHashFn, outBuffer, outSize);
 	case ENTERPRISE_KEY:
 	case ENTERPRISE_SCRIPT:
-		return deriveAddress_enterprise(addressParams, outBuffer, outSize);
+		return deriveAddress_enterprise(addressParams, keyHashFn, outBuffer, outSize);
 	case REWARD_KEY:
 	case REWARD_SCRIPT:
-		return deriveAddress_reward(addressParams, outBuffer, outSize);
+		return deriveAddress_reward(addressParams, keyHashFn, outBuffer, outSize);
 
 		#ifdef APP_FEATURE_BYRON_ADDRESS_DERIVATION
 	case BYRON:
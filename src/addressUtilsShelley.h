@@ -91,6 +91,16 @@ staking_data_source_t determineStakingChoice(address_type_t addressType);
 
 size_t deriveAddress(const addressParams_t* addressParams, uint8_t* outBuffer, size_t outSize);
 
+// computes the key hash of a path, bip44_pathToKeyHash or a cached equivalent
+typedef void key_hash_fn_t(const bip44_path_t* pathSpec, uint8_t* hash, size_t hashSize);
+
+// Byron addresses are derived from the extended public key, not from keyHashFn
+size_t deriveAddressWithKeyHashFn(
+        const addressParams_t* addressParams,
+        key_hash_fn_t* keyHashFn,
+        uint8_t* outBuffer, size_t outSize
+);
+
 __noinline_due_to_stack__
 size_t constructRewardAddressFromKeyPath(
         const bip44_path_t* path, uint8_t networkId, uint8_t* outBuffer, size_t outSize
@@ -36,7 +36,8 @@ typedef struct {
 	uint8_t expert;
 } app_mode_persistent_t;
 
-#if defined(TARGET_NANOS) || defined(TARGET_NANOX) || defined(TARGET_NANOS2)
+// host builds (fuzzing, native) have no NVM to write, the mode lives in RAM
+#if (defined(TARGET_NANOS) || defined(TARGET_NANOX) || defined(TARGET_NANOS2)) && !defined(FUZZING)
 //////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////
@@ -42,15 +42,17 @@ typedef enum {
 	CIP36 = 2
 } cvote_registration_format_t;
 
+// holds two buffered hash contexts, i.e. 2 * HASH_BUFFER_SIZE bytes
+// more than the plain ones (except on Nano S where they are the same)
 typedef struct {
 	struct {
-		blake2b_256_context_t payloadHash;
+		blake2b_256_buffered_context_t payloadHash;
 		cvote_registration_format_t format;
 		uint16_t remainingDelegations;
 	} cVoteRegistrationData;
 
 	aux_data_hash_builder_state_t state;
-	blake2b_256_context_t auxDataHash;
+	blake2b_256_buffered_context_t auxDataHash;
 } aux_data_hash_builder_t;
 
 
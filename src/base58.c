@@ -25,10 +25,83 @@
 /* cspell:disable-next-line */
 static const char BASE58ALPHABET[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
 
+// the encoder works with big endian 32-bit limbs and divides them by 58^5 in one pass,
+// producing 5 digits per pass
+#define LIMB_DIVISOR 656356768u // 58^5
+#define DIGITS_PER_LIMB_DIVISION 5
+#define MAX_LIMBS ((MAX_BUFFER_SIZE + 3) / 4)
+
 size_t base58_encode(
         const uint8_t* inBuffer, size_t inSize,
         char* outStr, size_t outMaxSize
 )
+{
+	uint32_t limbs[MAX_LIMBS] = {0};
+	char buffer[MAX_BUFFER_SIZE * 2] = {0};
+	size_t zeroCount = 0;
+
+	ASSERT(inSize <= MAX_BUFFER_SIZE);
+	ASSERT(outMaxSize < BUFFER_SIZE_PARANOIA);
+
+	while ((zeroCount < inSize) && (inBuffer[zeroCount] == 0)) {
+		++zeroCount;
+	}
+
+	// the first limb takes the bytes above the last multiple of 4
+	const size_t limbCount = (inSize + 3) / 4;
+	const size_t paddingSize = 4 * limbCount - inSize;
+	for (size_t i = 0; i < inSize; i++) {
+		const size_t position = paddingSize + i;
+		limbs[position / 4] |= (uint32_t) inBuffer[i] << (8 * (3 - position % 4));
+	}
+
+	size_t j = SIZEOF(buffer);
+	size_t startAt = 0;
+	while ((startAt < limbCount) && (limbs[startAt] == 0)) {
+		++startAt;
+	}
+
+	while (startAt < limbCount) {
+		uint32_t remainder = 0;
+		for (size_t divLoop = startAt; divLoop < limbCount; divLoop++) {
+			const uint64_t tmpDiv = ((uint64_t) remainder << 32) | limbs[divLoop];
+			limbs[divLoop] = (uint32_t) (tmpDiv / LIMB_DIVISOR);
+			remainder = (uint32_t) (tmpDiv % LIMB_DIVISOR);
+		}
+		while ((startAt < limbCount) && (limbs[startAt] == 0)) {
+			++startAt;
+		}
+		for (size_t digit = 0; digit < DIGITS_PER_LIMB_DIVISION; digit++) {
+			ASSERT((0 < j) && (j <= SIZEOF(buffer)));
+			buffer[--j] = BASE58ALPHABET[remainder % 58];
+			remainder /= 58;
+		}
+	}
+	// the last pass pads the most significant digits with zeros
+	while ((j < SIZEOF(buffer)) && (buffer[j] == BASE58ALPHABET[0])) {
+		++j;
+	}
+	while (zeroCount-- > 0) {
+		ASSERT((0 < j) && (j <= SIZEOF(buffer)));
+		buffer[--j] = BASE58ALPHABET[0];
+	}
+	size_t outSize = SIZEOF(buffer) - j;
+
+	ASSERT(outSize < outMaxSize);
+
+	memmove(outStr, (buffer + j), outSize);
+	outStr[outSize] = 0;
+	return outSize;
+}
+
+#ifdef DEVEL
+
+// the previous encoder dividing by 58 one byte at a time; the 58^5 limb
+// remainders of base58_encode must expand to the same digits and leading ones
+size_t base58_encode_bytewise(
+        const uint8_t* inBuffer, size_t inSize,
+        char* outStr, size_t outMaxSize
+)
 {
 	uint8_t tmpBuffer[MAX_BUFFER_SIZE] = {0};
 	uint8_t buffer[MAX_BUFFER_SIZE * 2] = {0};
@@ -76,3 +149,5 @@ size_t base58_encode(
 	outStr[outSize] = 0;
 	return outSize;
 }
+
+#endif // DEVEL
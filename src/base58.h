@@ -11,6 +11,11 @@ size_t base58_encode(
 
 
 #ifdef DEVEL
+size_t base58_encode_bytewise(
+        const uint8_t* inBuffer, size_t inSize,
+        char* outStr, size_t outMaxSize
+);
+
 void run_base58_test();
 #endif // DEVEL
 
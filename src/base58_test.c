@@ -17,6 +17,41 @@ void testcase_base58(const char* inputHex, const char* expectedStr)
 	EXPECT_EQ_BYTES(expectedStr, outputStr, outputLen + 1);
 }
 
+// random inputs of all sizes, with leading zeros and 0xff bytes
+static void test_base58_matchesBytewise()
+{
+	uint32_t seed = 0x12345678;
+	for (size_t inputSize = 0; inputSize <= 124; inputSize++) {
+		for (size_t variant = 0; variant < 4; variant++) {
+			uint8_t input[124] = {0};
+			for (size_t i = 0; i < inputSize; i++) {
+				seed = seed * 1103515245 + 12345;
+				input[i] = (uint8_t) (seed >> 16);
+			}
+			switch (variant) {
+			case 1:
+				memset(input, 0, inputSize / 3);
+				break;
+			case 2:
+				memset(input, 0xff, inputSize);
+				break;
+			case 3:
+				memset(input, 0, inputSize);
+				break;
+			default:
+				break;
+			}
+
+			char expected[250] = {0};
+			const size_t expectedLen = base58_encode_bytewise(input, inputSize, expected, SIZEOF(expected));
+			char output[250] = {0};
+			const size_t outputLen = base58_encode(input, inputSize, output, SIZEOF(output));
+			EXPECT_EQ(outputLen, expectedLen);
+			EXPECT_EQ_BYTES(output, expected, expectedLen + 1);
+		}
+	}
+}
+
 void run_base58_test()
 {
 	struct {
@@ -53,6 +88,8 @@ void run_base58_test()
 	ITERATE(it, testVectors) {
 		testcase_base58(PTR_PIC(it->inputHex), PTR_PIC(it->expectedHex));
 	}
+
+	test_base58_matchesBytewise();
 }
 
 #endif // DEVEL
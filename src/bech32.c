@@ -37,20 +37,26 @@ static const char* charset = "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
 
 /** Encode a Bech32 string
  *
- *  Out: output:  Pointer to a buffer of size >= strlen(hrp) + data_len + 8 that
- *                will be updated to contain the null-terminated Bech32 string.
- *  In: hrp :     Pointer to the null-terminated human readable part.
- *      data :    Pointer to an array of 5-bit values.
- *      data_len: Length of the data array.
+ *  The bytes are converted to 5-bit groups, added to the checksum
+ *  and written to the output in a single pass.
  */
-void bech32_encode_5bit(const char* hrp, const uint8_t* data,
-                        size_t data_len, char* output, size_t maxOutputSize)
+size_t bech32_encode(const char* hrp, const uint8_t* bytes, size_t bytesSize,
+                     char* output, size_t maxOutputSize)
 {
+	ASSERT(strlen(hrp) >= 1); // not allowed for bech32
+
+	const size_t SEPARATOR_LEN = 1;
+	const size_t CHECKSUM_LEN = 6;
+	size_t ceiling = (8 * bytesSize + 4) / 5; // ceiling of 8/5 * bytesLen (base32 encoding with padding)
+	size_t supposedOutputLength = strlen(hrp) + SEPARATOR_LEN + ceiling + CHECKSUM_LEN;
+	ASSERT(maxOutputSize >= supposedOutputLength + 1);
 	ASSERT(maxOutputSize < BUFFER_SIZE_PARANOIA);
-	ASSERT(maxOutputSize >= strlen(hrp) + data_len + 8);
+	ASSERT(bytesSize < BUFFER_SIZE_PARANOIA);
+
+	char* out = output;
 	const char* outputLimit = output + maxOutputSize;
 
-#define APPEND_OUT(value) {ASSERT(output < outputLimit); *(output++) = (value);}
+#define APPEND_OUT(value) {ASSERT(out < outputLimit); *(out++) = (value);}
 
 	uint32_t chk = 1;
 	{
@@ -70,41 +76,8 @@ void bech32_encode_5bit(const char* hrp, const uint8_t* data,
 
 	APPEND_OUT('1');
 
-	for (size_t i = 0; i < data_len; ++i) {
-		ASSERT((*data >> 5) == 0);
-		chk = bech32_polymod_step(chk) ^ (*data);
-		APPEND_OUT(charset[*(data++)]);
-	}
-	for (size_t i = 0; i < 6; ++i) {
-		chk = bech32_polymod_step(chk);
-	}
-	chk ^= 1;
-	for (size_t i = 0; i < 6; ++i) {
-		APPEND_OUT(charset[(chk >> ((5 - i) * 5)) & 0x1f]);
-	}
-	APPEND_OUT(0);
-}
+#define APPEND_DATA(value5bit) {chk = bech32_polymod_step(chk) ^ (value5bit); APPEND_OUT(charset[value5bit]);}
 
-// we are not supposed to use more for Cardano Shelley
-// WARNING: increasing this would take more stack space, see data5bit definition below
-#define MAX_BYTES 65
-
-size_t bech32_encode(const char* hrp, const uint8_t* bytes, size_t bytesSize,
-                     char* output, size_t maxOutputSize)
-{
-	ASSERT(bytesSize <= MAX_BYTES);
-	ASSERT(strlen(hrp) >= 1); // not allowed for bech32
-
-	const size_t SEPARATOR_LEN = 1;
-	const size_t CHECKSUM_LEN = 6;
-	size_t ceiling = (8 * bytesSize + 4) / 5; // ceiling of 8/5 * bytesLen (base32 encoding with padding)
-	size_t supposedOutputLength = strlen(hrp) + SEPARATOR_LEN + ceiling + CHECKSUM_LEN;
-	ASSERT(maxOutputSize >= supposedOutputLength + 1);
-	ASSERT(maxOutputSize < BUFFER_SIZE_PARANOIA);
-	ASSERT(bytesSize < BUFFER_SIZE_PARANOIA);
-
-	uint8_t data5bit[(8 * MAX_BYTES + 4) / 5] = {0}; // ceiling of (8/5 * MAX_BYTES_LEN) = 104
-	size_t data5bitLength = 0;
 	{
 		const int OUTBITS = 5;
 		const int INBITS = 8;
@@ -118,17 +91,28 @@ size_t bech32_encode(const char* hrp, const uint8_t* bytes, size_t bytesSize,
 			bits += INBITS;
 			while (bits >= OUTBITS) {
 				bits -= OUTBITS;
-				ASSERT(data5bitLength < SIZEOF(data5bit));
-				data5bit[data5bitLength++] = (val >> bits) & maxv;
+				const uint8_t value5bit = (val >> bits) & maxv;
+				APPEND_DATA(value5bit);
 			}
 		}
 		if (bits) {
-			ASSERT(data5bitLength < SIZEOF(data5bit));
-			data5bit[data5bitLength++] = (val << (OUTBITS - bits)) & maxv;
+			const uint8_t value5bit = (val << (OUTBITS - bits)) & maxv;
+			APPEND_DATA(value5bit);
 		}
 	}
 
-	bech32_encode_5bit(hrp, data5bit, data5bitLength, output, maxOutputSize);
+	for (size_t i = 0; i < 6; ++i) {
+		chk = bech32_polymod_step(chk);
+	}
+	chk ^= 1;
+	for (size_t i = 0; i < 6; ++i) {
+		APPEND_OUT(charset[(chk >> ((5 - i) * 5)) & 0x1f]);
+	}
+	APPEND_OUT(0);
+
+#undef APPEND_DATA
+#undef APPEND_OUT
+
 	ASSERT(strlen(output) == supposedOutputLength);
 
 	return supposedOutputLength;
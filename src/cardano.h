@@ -93,6 +93,8 @@ typedef struct {
 
 typedef struct {
 	uint8_t policyId[MINTING_POLICY_ID_SIZE];
+	// false if no token of the policy is in the registry, see tokens_isPolicyInRegistry
+	bool isPolicyInRegistry;
 } token_group_t;
 
 typedef struct {
@@ -101,6 +103,11 @@ typedef struct {
 	uint64_t amount;
 } output_token_amount_t;
 
+// tokens packed in a single APDU, except for the first one, are kept until processed;
+// in output_context_t, the buffer shares a union with datum chunks, but it grows
+// mint_context_t, which must stay within output_context_t (see signTx.h)
+#define PACKED_TOKENS_BUFFER_SIZE 160
+
 // ==============================  CERTIFICATES  ==============================
 
 #define ANCHOR_URL_LENGTH_MAX 128
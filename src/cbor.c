@@ -10,6 +10,20 @@ static const uint64_t VALUE_W2_UPPER_THRESHOLD = (uint64_t) 1 << 8;
 static const uint64_t VALUE_W4_UPPER_THRESHOLD = (uint64_t) 1 << 16;
 static const uint64_t VALUE_W8_UPPER_THRESHOLD = (uint64_t) 1 << 32;
 
+typedef struct {
+	uint8_t additionalInfo;
+	uint8_t width;
+} cbor_header_width_t;
+
+// indexed by the number of significant bytes of a value not fitting into the initial byte
+static const cbor_header_width_t HEADER_WIDTHS[] = {
+	{0, 0}, // unused, values below 24 are stored in the initial byte
+	{24, 1},
+	{25, 2},
+	{26, 4}, {26, 4},
+	{27, 8}, {27, 8}, {27, 8}, {27, 8},
+};
+
 
 cbor_token_t cbor_parseToken(const uint8_t* buf, size_t size)
 {
@@ -155,27 +169,20 @@ size_t cbor_writeToken(uint8_t type, uint64_t value, uint8_t* buffer, size_t buf
 		CHECK_BUF_LEN(1);
 		u1be_write(buffer, (uint8_t) (type | value));
 		return 1;
-	} else if (value < VALUE_W2_UPPER_THRESHOLD) {
-		CHECK_BUF_LEN(1 + 1);
-		u1be_write(buffer, type | 24);
-		u1be_write(buffer + 1, (uint8_t) value);
-		return 1 + 1;
-	} else if (value < VALUE_W4_UPPER_THRESHOLD) {
-		CHECK_BUF_LEN(1 + 2);
-		u1be_write(buffer, type | 25);
-		u2be_write(buffer + 1, (uint16_t) value);
-		return 1 + 2;
-	} else if (value < VALUE_W8_UPPER_THRESHOLD) {
-		CHECK_BUF_LEN(1 + 4);
-		u1be_write(buffer, type | 26);
-		u4be_write(buffer + 1, (uint32_t) value);
-		return 1 + 4;
-	} else {
-		CHECK_BUF_LEN(1 + 8);
-		u1be_write(buffer, type | 27);
-		u8be_write(buffer + 1, value);
-		return 1 + 8;
 	}
+
+	// the header width is looked up by the number of significant bytes of the value
+	// (1 to 8, the value is not zero here)
+	STATIC_ASSERT(ARRAY_LEN(HEADER_WIDTHS) == 1 + 8, "wrong header width table size");
+	const size_t valueBytes = 8 - (size_t) __builtin_clzll(value) / 8;
+	const cbor_header_width_t headerWidth = HEADER_WIDTHS[valueBytes];
+
+	CHECK_BUF_LEN(1 + headerWidth.width);
+	u1be_write(buffer, type | headerWidth.additionalInfo);
+	for (size_t i = 0; i < headerWidth.width; i++) {
+		buffer[headerWidth.width - i] = (uint8_t) (value >> (8 * i));
+	}
+	return 1 + headerWidth.width;
 #undef CHECK_BUF_LEN
 }
 
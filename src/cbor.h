@@ -44,6 +44,11 @@ enum {
 	CBOR_TAG_SET = 258,
 };
 
+enum {
+	// the initial byte and 8 bytes of the value
+	CBOR_TOKEN_SIZE_MAX = 9,
+};
+
 typedef struct {
 	uint8_t type;
 	uint8_t width; // Contains number of *additional* bytes carrying the value
@@ -124,6 +124,10 @@ static void test_cbor_serialization()
 		{"1a000f4240", CBOR_TYPE_UNSIGNED, 1000000},
 
 		{"1b000000e8d4a51000", CBOR_TYPE_UNSIGNED, 1000000000000},
+		// the upper bytes of 8-byte values (header width lookup)
+		{"1b0000ffffffffffff", CBOR_TYPE_UNSIGNED, 0xffffffffffffu},
+		{"1b00ffffffffffffff", CBOR_TYPE_UNSIGNED, 0xffffffffffffffu},
+		{"1b0100000000000000", CBOR_TYPE_UNSIGNED, 0x100000000000000u},
 		{"1bffFFffFFffFFffFF", CBOR_TYPE_UNSIGNED, 18446744073709551615u},
 
 		//0b0010 0000
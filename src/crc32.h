@@ -3,8 +3,13 @@
 
 #include "common.h"
 
+// table-driven with APP_FEATURE_CRC32_TABLE, bitwise otherwise (smaller, for Nano S)
 uint32_t crc32(const uint8_t* inBuffer, size_t inSize);
 
+#if !defined(APP_FEATURE_CRC32_TABLE) || defined(DEVEL)
+uint32_t crc32_bitwise(const uint8_t* inBuffer, size_t inSize);
+#endif
+
 
 #ifdef DEVEL
 void run_crc32_test();
@@ -4,6 +4,31 @@
 #include "hexUtils.h"
 #include "testUtils.h"
 
+static void test_crc32_matchesBitwise()
+{
+	// all inputs of up to 2 bytes
+	uint8_t buffer[124] = {0};
+	EXPECT_EQ(crc32(buffer, 0), crc32_bitwise(buffer, 0));
+	for (size_t first = 0; first < 256; first++) {
+		buffer[0] = (uint8_t) first;
+		EXPECT_EQ(crc32(buffer, 1), crc32_bitwise(buffer, 1));
+		for (size_t second = 0; second < 256; second++) {
+			buffer[1] = (uint8_t) second;
+			EXPECT_EQ(crc32(buffer, 2), crc32_bitwise(buffer, 2));
+		}
+	}
+
+	// pseudo-random inputs of all sizes up to the size of a large Byron address
+	uint32_t seed = 0x87654321;
+	for (size_t size = 0; size <= SIZEOF(buffer); size++) {
+		for (size_t i = 0; i < size; i++) {
+			seed = seed * 1103515245 + 12345;
+			buffer[i] = (uint8_t) (seed >> 16);
+		}
+		EXPECT_EQ(crc32(buffer, size), crc32_bitwise(buffer, size));
+	}
+}
+
 void run_crc32_test()
 {
 	const struct {
@@ -32,7 +57,10 @@ void run_crc32_test()
 		uint32_t result = crc32(buffer, bufferSize);
 
 		EXPECT_EQ(result, it->expected);
+		EXPECT_EQ(crc32_bitwise(buffer, bufferSize), it->expected);
 	}
+
+	test_crc32_matchesBitwise();
 }
 
 #endif // DEVEL
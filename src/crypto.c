@@ -21,6 +21,8 @@
 #include "cx.h"
 #include "os.h"
 
+#include "perfCounters.h"
+
 static cx_err_t crypto_init_privkey(
         const uint32_t* path,
         size_t path_len,
@@ -30,6 +32,8 @@ static cx_err_t crypto_init_privkey(
 	cx_err_t error = CX_OK;
 	uint8_t raw_privkey[64];
 
+	PERF_COUNTERS_ADD(derivations, 1);
+
 	// Derive private key according to BIP32 path
 	CX_CHECK(os_derive_bip32_no_throw(CX_CURVE_Ed25519,
 	                                  path,
@@ -128,6 +132,7 @@ WARN_UNUSED_RESULT cx_err_t crypto_eddsa_sign(
 	                             NULL));
 
 
+	PERF_COUNTERS_ADD(signatures, 1);
 	CX_CHECK(cx_eddsa_sign_no_throw((const struct cx_ecfp_256_private_key_s*) &privkey,
 	                                CX_SHA512,
 	                                hash,
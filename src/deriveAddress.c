@@ -19,8 +19,15 @@ static uint16_t RESPONSE_READY_MAGIC = 11223;
 static ins_derive_address_context_t* ctx = &(instructionState.deriveAddressContext);
 
 enum {
-	P1_RETURN  = 0x01,
-	P1_DISPLAY = 0x02,
+	P1_RETURN       = 0x01,
+	P1_DISPLAY      = 0x02,
+	P1_RETURN_RANGE = 0x03,
+};
+
+// P2 values for P1_RETURN_RANGE
+enum {
+	P2_RANGE_INIT = P2_UNUSED,
+	P2_RANGE_NEXT = 0x01,
 };
 
 void deriveAddress_response(void)
@@ -302,6 +309,138 @@ static void deriveAddress_display_ui_runStep()
 	UI_STEP_END(DISPLAY_UI_STEP_INVALID);
 }
 
+/* ========================== RETURN ADDRESS RANGE ========================== */
+
+// fills the response with as many of the remaining addresses as fit into it
+__noinline_due_to_stack__
+static void _prepareRangeResponse()
+{
+	TRACE_STACK_USAGE();
+	ASSERT(ctx->isRangeInProgress);
+	ASSERT(ctx->range.numRemaining > 0);
+
+	write_view_t out = make_write_view(ctx->range.response, ctx->range.response + SIZEOF(ctx->range.response));
+
+	while (ctx->range.numRemaining > 0) {
+		ctx->addressParams.paymentKeyPath.path[BIP44_I_ADDRESS] = ctx->range.nextIndex;
+
+		uint8_t addressBuffer[MAX_ADDRESS_SIZE] = {0};
+		const size_t addressSize = deriveAddress(
+		                                   &ctx->addressParams,
+		                                   addressBuffer, SIZEOF(addressBuffer)
+		                           );
+		ASSERT(addressSize <= SIZEOF(addressBuffer));
+		STATIC_ASSERT(MAX_ADDRESS_SIZE <= UINT8_MAX, "address size does not fit into u1");
+
+		if (1 + addressSize > view_remainingSize(&out)) {
+			// the address is derived again for the next response
+			ASSERT(view_processedSize(&out) > 0);
+			break;
+		}
+
+		const uint8_t size = (uint8_t) addressSize;
+		view_appendBuffer(&out, &size, 1);
+		view_appendBuffer(&out, addressBuffer, addressSize);
+
+		ctx->range.nextIndex++;
+		ctx->range.numRemaining--;
+	}
+
+	ctx->range.responseSize = view_processedSize(&out);
+	ctx->responseReadyMagic = RESPONSE_READY_MAGIC;
+}
+
+static void _respondRange()
+{
+	ASSERT(ctx->responseReadyMagic == RESPONSE_READY_MAGIC);
+	ctx->responseReadyMagic = 0;
+	ASSERT(ctx->range.responseSize <= SIZEOF(ctx->range.response));
+
+	io_send_buf(SUCCESS, ctx->range.response, ctx->range.responseSize);
+
+	if (ctx->range.numRemaining == 0) {
+		ctx->isRangeInProgress = false;
+		ui_idle();
+	} else {
+		#ifdef HAVE_BAGL
+		ui_displayBusy(); // needs to happen after I/O
+		#endif // HAVE_BAGL
+	}
+}
+
+static void deriveAddress_handleReturnRangeInit(read_view_t* view, bool isNewCall)
+{
+	// a range is only started by a new instruction
+	VALIDATE(isNewCall, ERR_INVALID_STATE);
+
+	view_parseAddressParams(view, &ctx->addressParams);
+	const uint32_t count = parse_u4be(view);
+	VALIDATE(view_remainingSize(view) == 0, ERR_INVALID_DATA);
+	VALIDATE(count > 0, ERR_INVALID_DATA);
+	VALIDATE(count <= DERIVE_ADDRESS_RANGE_MAX, ERR_INVALID_DATA);
+
+	// the range goes over the address index of the payment path
+	VALIDATE(determinePaymentChoice(ctx->addressParams.type) == PAYMENT_PATH, ERR_INVALID_DATA);
+	bip44_path_t* paymentKeyPath = &ctx->addressParams.paymentKeyPath;
+	VALIDATE(bip44_containsAddress(paymentKeyPath), ERR_INVALID_DATA);
+	const uint32_t startIndex = paymentKeyPath->path[BIP44_I_ADDRESS];
+	VALIDATE(!isHardened(startIndex), ERR_INVALID_DATA);
+	VALIDATE(!isHardened(startIndex + count - 1), ERR_INVALID_DATA);
+
+	// every address of the range must be returnable without any prompt
+	for (uint32_t i = 0; i < count; i++) {
+		paymentKeyPath->path[BIP44_I_ADDRESS] = startIndex + i;
+
+		security_policy_t policy = policyForReturnDeriveAddress(&ctx->addressParams);
+		TRACE("Policy: %d", (int) policy);
+		ENSURE_NOT_DENIED(policy);
+		VALIDATE(policy == POLICY_ALLOW_WITHOUT_PROMPT, ERR_REJECTED_BY_POLICY);
+	}
+
+	if (ctx->addressParams.stakingDataSource == STAKING_KEY_PATH) {
+		// the staking part is the same in all the addresses
+		ASSERT(ctx->addressParams.type == BASE_PAYMENT_KEY_STAKE_KEY);
+		uint8_t stakingKeyHash[ADDRESS_KEY_HASH_LENGTH] = {0};
+		bip44_pathToKeyHash(&ctx->addressParams.stakingKeyPath, stakingKeyHash, SIZEOF(stakingKeyHash));
+
+		STATIC_ASSERT(SIZEOF(ctx->addressParams.stakingKeyHash) == SIZEOF(stakingKeyHash), "wrong staking key hash size");
+		memmove(ctx->addressParams.stakingKeyHash, stakingKeyHash, SIZEOF(stakingKeyHash));
+		ctx->addressParams.stakingDataSource = STAKING_KEY_HASH;
+	}
+
+	ctx->isRangeInProgress = true;
+	ctx->range.nextIndex = startIndex;
+	ctx->range.numRemaining = count;
+
+	_prepareRangeResponse();
+	_respondRange();
+}
+
+static void deriveAddress_handleReturnRangeNext(read_view_t* view)
+{
+	VALIDATE(ctx->isRangeInProgress, ERR_INVALID_STATE);
+	VALIDATE(view_remainingSize(view) == 0, ERR_INVALID_DATA);
+
+	_prepareRangeResponse();
+	_respondRange();
+}
+
+static void deriveAddress_handleReturnRange(uint8_t p2, read_view_t* view, bool isNewCall)
+{
+	switch (p2) {
+	case P2_RANGE_INIT:
+		deriveAddress_handleReturnRangeInit(view, isNewCall);
+		break;
+
+	case P2_RANGE_NEXT:
+		deriveAddress_handleReturnRangeNext(view);
+		break;
+
+	default:
+		THROW(ERR_INVALID_REQUEST_PARAMETERS);
+	}
+}
+
 /* ========================== TOP-LEVEL HANDLER ========================== */
 
 void deriveAddress_handleAPDU(
@@ -312,7 +451,6 @@ void deriveAddress_handleAPDU(
         bool isNewCall
 )
 {
-	VALIDATE(p2 == P2_UNUSED, ERR_INVALID_REQUEST_PARAMETERS);
 	TRACE_BUFFER(wireDataBuffer, wireDataSize);
 
 	// Initialize state
@@ -323,6 +461,15 @@ void deriveAddress_handleAPDU(
 
 	read_view_t view = make_read_view(wireDataBuffer, wireDataBuffer + wireDataSize);
 
+	if (p1 == P1_RETURN_RANGE) {
+		// the rest of the range is requested with empty APDUs
+		deriveAddress_handleReturnRange(p2, &view, isNewCall);
+		return;
+	}
+	// a range in progress is only continued
+	VALIDATE(!ctx->isRangeInProgress, ERR_INVALID_STATE);
+	VALIDATE(p2 == P2_UNUSED, ERR_INVALID_REQUEST_PARAMETERS);
+
 	view_parseAddressParams(&view, &ctx->addressParams);
 
 	VALIDATE(view_remainingSize(&view) == 0, ERR_INVALID_DATA);
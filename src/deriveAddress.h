@@ -8,13 +8,29 @@
 
 handler_fn_t deriveAddress_handleAPDU;
 
+// the number of addresses returned by a single range request
+#define DERIVE_ADDRESS_RANGE_MAX 100
+
+// the addresses of a range are streamed in responses of at most this size
+#define DERIVE_ADDRESS_RANGE_RESPONSE_SIZE 240
+
 typedef struct {
 	uint16_t responseReadyMagic;
 	addressParams_t addressParams;
-	struct {
-		uint8_t buffer[MAX_ADDRESS_SIZE];
-		size_t size;
-	} address;
+	bool isRangeInProgress;
+	union {
+		struct {
+			uint8_t buffer[MAX_ADDRESS_SIZE];
+			size_t size;
+		} address;
+		struct {
+			// the address index (the last payment path element) of the next address
+			uint32_t nextIndex;
+			uint32_t numRemaining;
+			uint8_t response[DERIVE_ADDRESS_RANGE_RESPONSE_SIZE];
+			size_t responseSize;
+		} range;
+	};
 	int ui_step;
 } ins_derive_address_context_t;
 
@@ -53,29 +53,37 @@ void keys_advanceStage()
 	}
 }
 
-// read a path from view into ctx->pathSpec
-static void parsePath(read_view_t* view)
+// read a path from view into the given path spec
+static void parsePath(read_view_t* view, bip44_path_t* pathSpec)
 {
-	view_skipBytes(view, bip44_parseFromWire(&ctx->pathSpec, VIEW_REMAINING_TO_TUPLE_BUF_SIZE(view)));
-	BIP44_PRINTF(&ctx->pathSpec);
+	view_skipBytes(view, bip44_parseFromWire(pathSpec, VIEW_REMAINING_TO_TUPLE_BUF_SIZE(view)));
+	BIP44_PRINTF(pathSpec);
 	PRINTF("\n");
 }
 
-// ============================== derivation for one key ==============================
+// ============================== derivation for a batch of keys ==============================
 
-// derive the key described by ctx->pathSpec and run the ui state machine accordingly
-void runGetOnePublicKeyUIFlow()
+// derive the keys described by ctx->pathSpecs and run the ui state machine accordingly
+void runGetPublicKeysUIFlow()
 {
 	ASSERT(ctx->ui_step == UI_STEP_NONE); // make sure no ui state machine is running
+	ASSERT(ctx->numBatchPaths > 0);
+	ASSERT(ctx->numBatchPaths <= GET_KEYS_BATCH_MAX);
 
 	ctx->responseReadyMagic = 0;
+	ctx->currentDisplayedPath = 0;
 
 	// Check security policy
-	security_policy_t policy = (ctx->numPaths == 1) ?
-	                           policyForGetExtendedPublicKey(&ctx->pathSpec) :
-	                           policyForGetExtendedPublicKeyBulkExport(&ctx->pathSpec);
-	TRACE("Policy: %d", (int) policy);
-	ENSURE_NOT_DENIED(policy);
+	security_policy_t policy = POLICY_ALLOW_WITHOUT_PROMPT;
+	for (size_t i = 0; i < ctx->numBatchPaths; i++) {
+		security_policy_t keyPolicy = (ctx->numPaths == 1) ?
+		                              policyForGetExtendedPublicKey(&ctx->pathSpecs[i]) :
+		                              policyForGetExtendedPublicKeyBulkExport(&ctx->pathSpecs[i]);
+		TRACE("Policy: %d", (int) keyPolicy);
+		ENSURE_NOT_DENIED(keyPolicy);
+
+		policy = combineBatchPolicies(policy, keyPolicy);
+	}
 
 	if (policy > POLICY_ALLOW_WITHOUT_PROMPT) {
 		ctx->silent_export = false;
@@ -83,10 +91,12 @@ void runGetOnePublicKeyUIFlow()
 
 	{
 		// Calculation
-		deriveExtendedPublicKey(
-		        & ctx->pathSpec,
-		        & ctx->extPubKey
-		);
+		for (size_t i = 0; i < ctx->numBatchPaths; i++) {
+			deriveExtendedPublicKey(
+			        & ctx->pathSpecs[i],
+			        & ctx->extPubKeys[i]
+			);
+		}
 		ctx->responseReadyMagic = RESPONSE_READY_MAGIC;
 	}
 
@@ -105,10 +115,12 @@ void runGetOnePublicKeyUIFlow()
 
 // ============================== INIT ==============================
 
-static void getPublicKeys_handleInitAPDU(const uint8_t* wireDataBuffer, size_t wireDataSize)
+static void getPublicKeys_handleInitAPDU(uint8_t p2, const uint8_t* wireDataBuffer, size_t wireDataSize)
 {
 	{
 		CHECK_STAGE(GET_KEYS_STAGE_INIT);
+
+		VALIDATE(p2 == P2_UNUSED, ERR_INVALID_REQUEST_PARAMETERS);
 	}
 	{
 		// parse data
@@ -116,7 +128,9 @@ static void getPublicKeys_handleInitAPDU(const uint8_t* wireDataBuffer, size_t w
 		TRACE_BUFFER(wireDataBuffer, wireDataSize);
 		read_view_t view = make_read_view(wireDataBuffer, wireDataBuffer + wireDataSize);
 
-		parsePath(&view);
+		// the first key is never packed with the others
+		ctx->numBatchPaths = 1;
+		parsePath(&view, &ctx->pathSpecs[0]);
 
 		size_t remaining = view_remainingSize(&view);
 		switch (remaining) {
@@ -178,6 +192,7 @@ static void getPublicKeys_handleInitAPDU(const uint8_t* wireDataBuffer, size_t w
 
 
 void getPublicKeys_handleGetNextKeyAPDU(
+        uint8_t p2,
         const uint8_t* wireDataBuffer,
         size_t wireDataSize
 )
@@ -186,16 +201,40 @@ void getPublicKeys_handleGetNextKeyAPDU(
 
 	VALIDATE(ctx->currentPath < ctx->numPaths, ERR_INVALID_STATE);
 
+	explicit_bzero(ctx->pathSpecs, SIZEOF(ctx->pathSpecs));
+	explicit_bzero(ctx->extPubKeys, SIZEOF(ctx->extPubKeys));
+
 	read_view_t view = make_read_view(wireDataBuffer, wireDataBuffer + wireDataSize);
-	parsePath(&view);
+
+	switch (p2) {
+	case GET_KEYS_P2_SINGLE:
+		ctx->numBatchPaths = 1;
+		break;
+
+	case GET_KEYS_P2_BATCH:
+		ctx->numBatchPaths = parse_u1be(&view);
+		VALIDATE(ctx->numBatchPaths > 0, ERR_INVALID_DATA);
+		VALIDATE(ctx->numBatchPaths <= GET_KEYS_BATCH_MAX, ERR_INVALID_DATA);
+		break;
+
+	default:
+		THROW(ERR_INVALID_REQUEST_PARAMETERS);
+	}
+
+	// the batch must not exceed the number of keys announced in init
+	VALIDATE(ctx->numBatchPaths <= ctx->numPaths - ctx->currentPath, ERR_INVALID_DATA);
+
+	for (size_t i = 0; i < ctx->numBatchPaths; i++) {
+		parsePath(&view, &ctx->pathSpecs[i]);
+	}
 	VALIDATE(view_remainingSize(&view) == 0, ERR_INVALID_DATA);
 
-	runGetOnePublicKeyUIFlow();
+	runGetPublicKeysUIFlow();
 }
 
 // ============================== MAIN HANDLER ==============================
 
-typedef void subhandler_fn_t(const uint8_t* dataBuffer, size_t dataSize);
+typedef void subhandler_fn_t(uint8_t p2, const uint8_t* dataBuffer, size_t dataSize);
 
 static subhandler_fn_t* lookup_subhandler(uint8_t p1)
 {
@@ -226,9 +265,8 @@ void getPublicKeys_handleAPDU(
 		ctx->stage = GET_KEYS_STAGE_INIT;
 		ctx->ui_step = UI_STEP_NONE;
 	}
-	VALIDATE(p2 == P2_UNUSED, ERR_INVALID_REQUEST_PARAMETERS);
 
 	subhandler_fn_t* subhandler = lookup_subhandler(p1);
 	VALIDATE(subhandler != NULL, ERR_INVALID_REQUEST_PARAMETERS);
-	subhandler(wireDataBuffer, wireDataSize);
+	subhandler(p2, wireDataBuffer, wireDataSize);
 }
@@ -14,14 +14,29 @@ typedef enum {
 	GET_KEYS_STAGE_GET_KEYS = 40
 } get_keys_stage_t;
 
+// P2 values for the APDUs requesting the remaining keys
+enum {
+	GET_KEYS_P2_SINGLE = P2_UNUSED,
+	GET_KEYS_P2_BATCH = 0x01,
+};
+
+enum {
+	// all keys must fit into a single response APDU
+	GET_KEYS_BATCH_MAX = 3,
+};
+
 typedef struct {
 	get_keys_stage_t stage;
 
 	uint16_t currentPath;
 	uint16_t numPaths;
 
-	bip44_path_t pathSpec;
-	extendedPublicKey_t extPubKey;
+	// paths requested in the current APDU (just one unless packed)
+	uint8_t numBatchPaths;
+	uint8_t currentDisplayedPath;
+	bip44_path_t pathSpecs[GET_KEYS_BATCH_MAX];
+	// kept contiguous so that they can be sent in a single response
+	extendedPublicKey_t extPubKeys[GET_KEYS_BATCH_MAX];
 
 	uint16_t responseReadyMagic;
 
@@ -31,7 +46,7 @@ typedef struct {
 
 handler_fn_t getPublicKeys_handleAPDU;
 
-void runGetOnePublicKeyUIFlow();
+void runGetPublicKeysUIFlow();
 void keys_advanceStage();
 
 #endif // H_CARDANO_APP_GET_PUBLIC_KEYS
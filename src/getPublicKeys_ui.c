@@ -15,7 +15,7 @@ static int16_t RESPONSE_READY_MAGIC = 23456;
 
 static ins_get_keys_context_t* ctx = &(instructionState.getKeysContext);
 
-// ============================== derivation and UI state machine for one key ==============================
+// ============================== derivation and UI state machine for a batch of keys ==============================
 
 #ifdef HAVE_NBGL
 static void getPublicKeys_respondOneKey_ui_cb(void)
@@ -25,7 +25,7 @@ static void getPublicKeys_respondOneKey_ui_cb(void)
 	ui_getPublicKeyPathScreen(
 	        line1, SIZEOF(line1),
 	        pathStr, SIZEOF(pathStr),
-	        &ctx->pathSpec
+	        &ctx->pathSpecs[ctx->currentDisplayedPath]
 	);
 	fill_and_display_if_required(line1, pathStr, getPublicKeys_respondOneKey_ui_runStep, respond_with_user_reject);
 }
@@ -53,11 +53,14 @@ void getPublicKeys_respondOneKey_ui_runStep()
 		#endif // HAVE_BAGL
 	}
 	UI_STEP(GET_KEY_UI_STEP_DISPLAY) {
+		ASSERT(ctx->currentDisplayedPath < ctx->numBatchPaths);
+		const bip44_path_t* pathSpec = &ctx->pathSpecs[ctx->currentDisplayedPath];
+
 		#ifdef HAVE_BAGL
-		ui_displayGetPublicKeyPathScreen(&ctx->pathSpec, this_fn);
+		ui_displayGetPublicKeyPathScreen(pathSpec, this_fn);
 		#elif defined(HAVE_NBGL)
 		set_light_confirmation(true);
-		bool showAccountDescription = (bip44_classifyPath(&ctx->pathSpec) == PATH_ORDINARY_ACCOUNT);
+		bool showAccountDescription = (bip44_classifyPath(pathSpec) == PATH_ORDINARY_ACCOUNT);
 		if (showAccountDescription) {
 			char line1[30];
 			char line2[30];
@@ -66,7 +69,7 @@ void getPublicKeys_respondOneKey_ui_runStep()
 			        SIZEOF(line1),
 			        line2,
 			        SIZEOF(line2),
-			        &ctx->pathSpec
+			        pathSpec
 			);
 			fill_and_display_if_required(line1, line2, getPublicKeys_respondOneKey_ui_cb, respond_with_user_reject);
 		} else {
@@ -74,19 +77,26 @@ void getPublicKeys_respondOneKey_ui_runStep()
 		}
 		#endif // HAVE_BAGL
 	}
+	UI_STEP(GET_KEY_UI_STEP_DISPLAY_NEXT) {
+		ctx->currentDisplayedPath++;
+		if (ctx->currentDisplayedPath < ctx->numBatchPaths) {
+			UI_STEP_JUMP(GET_KEY_UI_STEP_DISPLAY);
+		}
+		UI_STEP_JUMP(GET_KEY_UI_STEP_CONFIRM);
+	}
 	UI_STEP(GET_KEY_UI_STEP_CONFIRM) {
 		#ifdef HAVE_BAGL
 		ui_displayPrompt(
 		        "Confirm export",
-		        "public key?",
+		        (ctx->numBatchPaths > 1) ? "public keys?" : "public key?",
 		        this_fn,
 		        respond_with_user_reject
 		);
 		#elif defined(HAVE_NBGL)
 		display_confirmation_no_approved_status(
-		        "Confirm\npublic key export",
+		        (ctx->numBatchPaths > 1) ? "Confirm\npublic keys export" : "Confirm\npublic key export",
 		        "",
-		        "Public key\nrejected",
+		        (ctx->numBatchPaths > 1) ? "Public keys\nrejected" : "Public key\nrejected",
 		        this_fn,
 		        respond_with_user_reject
 		);
@@ -95,13 +105,17 @@ void getPublicKeys_respondOneKey_ui_runStep()
 	UI_STEP(GET_KEY_UI_STEP_RESPOND) {
 		ASSERT(ctx->responseReadyMagic == RESPONSE_READY_MAGIC);
 
-		io_send_buf(SUCCESS, (uint8_t*) &ctx->extPubKey, SIZEOF(ctx->extPubKey));
+		const size_t responseSize = ctx->numBatchPaths * SIZEOF(ctx->extPubKeys[0]);
+		ASSERT(responseSize <= SIZEOF(ctx->extPubKeys));
+
+		io_send_buf(SUCCESS, (uint8_t*) ctx->extPubKeys, responseSize);
 		ctx->responseReadyMagic = 0; // just for safety
 		#ifdef HAVE_BAGL
 		ui_displayBusy(); // needs to happen after I/O
 		#endif // HAVE_BAGL
 
-		ctx->currentPath++;
+		ctx->currentPath += ctx->numBatchPaths;
+		ASSERT(ctx->currentPath <= ctx->numPaths);
 		TRACE("Current path: %u / %u", ctx->currentPath, ctx->numPaths);
 
 		if (ctx->currentPath == ctx->numPaths) {
@@ -162,7 +176,7 @@ void getPublicKeys_handleInit_ui_runStep()
 	UI_STEP(HANDLE_INIT_UI_STEP_RESPOND) {
 		ctx->ui_step = UI_STEP_NONE; // we are finished with this UI state machine
 
-		runGetOnePublicKeyUIFlow(); // run another UI state machine
+		runGetPublicKeysUIFlow(); // run another UI state machine
 
 		// This return statement is needed to bail out from this UI state machine
 		// which would otherwise be in conflict with the (async) UI state
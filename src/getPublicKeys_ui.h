@@ -5,12 +5,13 @@
 // it should be set to this value at the beginning and after a UI state machine is finished
 static int UI_STEP_NONE = 0;
 
-// ============================== derivation and UI state machine for one key ==============================
+// ============================== derivation and UI state machine for a batch of keys ==============================
 
 enum {
 	GET_KEY_UI_STEP_WARNING = 200,
 	GET_KEY_UI_STEP_PROMPT,
 	GET_KEY_UI_STEP_DISPLAY,
+	GET_KEY_UI_STEP_DISPLAY_NEXT,
 	GET_KEY_UI_STEP_CONFIRM,
 	GET_KEY_UI_STEP_RESPOND,
 } ;
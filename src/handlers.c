@@ -8,6 +8,7 @@
 #include "getSerial.h"
 #include "getPublicKeys.h"
 #include "runTests.h"
+#include "perfCounters.h"
 #include "errors.h"
 #include "deriveAddress.h"
 #include "deriveNativeScriptHash.h"
@@ -15,6 +16,11 @@
 #include "signMsg.h"
 #include "signOpCert.h"
 #include "signCVote.h"
+#include "state.h"
+#include "keyDerivation.h"
+#include "signTxSession.h"
+
+static const uint8_t CLA = 0xD7;
 
 // The APDU protocol uses a single-byte instruction code (INS) to specify
 // which command should be executed. We'll use this code to dispatch on a
@@ -35,7 +41,7 @@ handler_fn_t* lookupHandler(uint8_t ins)
 		#endif // APP_FEATURE_NATIVE_SCRIPT_HASH
 
 		// 0x2* -  signing related
-		CASE(0x21, signTx_handleAPDU);
+		CASE(INS_SIGN_TX, signTx_handleAPDU);
 		#ifdef APP_FEATURE_OPCERT
 		CASE(0x22, signOpCert_handleAPDU);
 		#endif // APP_FEATURE_OPCERT
@@ -46,6 +52,7 @@ handler_fn_t* lookupHandler(uint8_t ins)
 		// 0xF* -  debug_mode related
 		CASE(0xF0, handleRunTests);
 		//   0xF1  reserved for INS_SET_HEADLESS_INTERACTION
+		CASE(0xF2, perfCounters_handleAPDU);
 		#endif // DEVEL
 #undef   CASE
 	default:
@@ -53,4 +60,111 @@ handler_fn_t* lookupHandler(uint8_t ins)
 	}
 }
 
+// The size of the instructionState variant used by the instruction.
+// An instruction reads no other part of the union, so only this prefix
+// needs to be cleared when the instruction starts.
+// Every instruction of lookupHandler must be listed (see state_test.c).
+size_t lookupInstructionStateSize(uint8_t ins)
+{
+	switch (ins) {
+#define  CASE(INS, STATE) case INS: return SIZEOF(instructionState.STATE);
+#define  NO_STATE(INS) case INS: return 0;
+		// 0x0* -  app status calls
+		NO_STATE(0x00);
+		NO_STATE(0x01);
+
+		// 0x1* -  public-key/address related
+		CASE(0x10, getKeysContext);
+		CASE(0x11, deriveAddressContext);
+		#ifdef APP_FEATURE_NATIVE_SCRIPT_HASH
+		CASE(0x12, deriveNativeScriptHashContext);
+		#endif // APP_FEATURE_NATIVE_SCRIPT_HASH
+
+		// 0x2* -  signing related
+		CASE(INS_SIGN_TX, signTxContext);
+		#ifdef APP_FEATURE_OPCERT
+		CASE(0x22, signOpCertContext);
+		#endif // APP_FEATURE_OPCERT
+		CASE(0x23, signCVoteContext);
+		CASE(0x24, signMsgContext);
+
+		#ifdef DEVEL
+		// 0xF* -  debug_mode related
+		// the tests set up the states they use
+		NO_STATE(0xF0);
+		NO_STATE(0xF2);
+		#endif // DEVEL
+#undef   CASE
+#undef   NO_STATE
+	default:
+		// an instruction missing here would start on stale bytes
+		ASSERT(false);
+		return SIZEOF(instructionState);
+	}
+}
+
+// Checks the header of a received APDU, starts a new instruction if none
+// is in progress and calls the handler of the instruction.
+// Errors are thrown, the caller turns them into responses.
+// Used by main.c and by the native APDU runner.
+void handleApdu(const uint8_t* apdu, size_t apduSize)
+{
+	// Note(ppershing): unsafe to access before checks
+	// Warning(ppershing): in case of unlikely change of APDU format
+	// make sure you read wider values as big endian
+	struct {
+		uint8_t cla;
+		uint8_t ins;
+		uint8_t p1;
+		uint8_t p2;
+		uint8_t lc;
+	} const* header = (const void*) apdu;
+
+	VALIDATE(apduSize >= SIZEOF(*header), ERR_MALFORMED_REQUEST_HEADER);
+
+	// check that data is safe to access
+	VALIDATE(apduSize == header->lc + SIZEOF(*header), ERR_MALFORMED_REQUEST_HEADER);
+
+	const uint8_t* data = apdu + SIZEOF(*header);
+
+	VALIDATE(header->cla == CLA, ERR_BAD_CLA);
+
+	TRACE("APDU: ins = %d,   p1 = %d,    p2 = %d", header->ins, header->p1, header->p2);
+
+	// Lookup and call the requested command handler.
+	handler_fn_t* handlerFn = lookupHandler(header->ins);
+
+	VALIDATE(handlerFn != NULL, ERR_UNKNOWN_INS);
+
+	bool isNewCall = false;
+	if (currentInstruction == INS_NONE) {
+		// clears just the variant of the new instruction, the whole state
+		// was wiped when the previous one finished, was rejected
+		// (see state_endInstruction) or was aborted (see main.c)
+		explicit_bzero(&instructionState, lookupInstructionStateSize(header->ins));
+		#ifdef APP_FEATURE_ACCOUNT_NODE_CACHE
+		keyDerivation_resetCache();
+		#endif // APP_FEATURE_ACCOUNT_NODE_CACHE
+		#ifdef APP_FEATURE_SIGN_TX_SESSION
+		signTxSession_startInstruction(header->ins, header->p1);
+		#endif // APP_FEATURE_SIGN_TX_SESSION
+		#ifdef DEVEL
+		perfCounters_startInstruction(header->ins);
+		#endif // DEVEL
+		isNewCall = true;
+		currentInstruction = header->ins;
+	} else {
+		VALIDATE(header->ins == currentInstruction, ERR_STILL_IN_CALL);
+	}
+	PERF_COUNTERS_ADD(apdus, 1);
+
+	// Note: handlerFn is responsible for calling io_send
+	// either during its call or subsequent UI actions
+	handlerFn(header->p1,
+	          header->p2,
+	          data,
+	          header->lc,
+	          isNewCall);
+}
+
 #endif
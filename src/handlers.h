@@ -3,6 +3,9 @@
 
 #include "common.h"
 
+// the instruction code of SIGN_TX, also needed by signTxSession.c
+#define INS_SIGN_TX 0x21
+
 typedef void handler_fn_t(
         uint8_t p1,
         uint8_t p2,
@@ -13,4 +16,8 @@ typedef void handler_fn_t(
 
 handler_fn_t* lookupHandler(uint8_t ins);
 
+size_t lookupInstructionStateSize(uint8_t ins);
+
+void handleApdu(const uint8_t* apdu, size_t apduSize);
+
 #endif // H_CARDANO_APP_HANDLERS
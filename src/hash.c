@@ -0,0 +1,5 @@
+#include "hash.h"
+
+#ifdef DEVEL
+uint32_t hash_engineCallCount;
+#endif // DEVEL
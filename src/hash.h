@@ -4,6 +4,7 @@
 #include <cx.h>
 
 #include "common.h"
+#include "perfCounters.h"
 
 // This file provides convenience functions for using firmware hashing api
 
@@ -23,6 +24,14 @@ enum {
 	HASH_CONTEXT_INITIALIZED_MAGIC = 12345,
 };
 
+#ifdef DEVEL
+// number of calls into the firmware hash engine, see run_hash_test
+extern uint32_t hash_engineCallCount;
+#define HASH_COUNT_ENGINE_CALL() hash_engineCallCount++
+#else
+#define HASH_COUNT_ENGINE_CALL()
+#endif // DEVEL
+
 #define __CIPHER_DECLARE(CIPHER, cipher, bits) \
 	typedef struct { \
 		uint16_t initialized_magic; \
@@ -50,6 +59,8 @@ enum {
 	        const uint8_t* inBuffer, size_t inSize \
 	                                                                           ) { \
 		ASSERT(ctx->initialized_magic == HASH_CONTEXT_INITIALIZED_MAGIC); \
+		HASH_COUNT_ENGINE_CALL(); \
+		PERF_COUNTERS_ADD(hashedBytes[PERF_HASH_##CIPHER], inSize); \
 		cx_err_t error = cx_hash_no_throw( \
 		                                   & ctx->cx_ctx.header, \
 		                                   0, /* Do not output the hash, yet */ \
@@ -69,6 +80,7 @@ enum {
 	                                                                             ) { \
 		ASSERT(ctx->initialized_magic == HASH_CONTEXT_INITIALIZED_MAGIC); \
 		ASSERT(outSize == CIPHER##_##bits##_SIZE); \
+		HASH_COUNT_ENGINE_CALL(); \
 		cx_err_t error = cx_hash_no_throw( \
 		                                   & ctx->cx_ctx.header, \
 		                                   CX_LAST, /* Output the hash */ \
@@ -105,6 +117,141 @@ __CIPHER_DECLARE(BLAKE2B, blake2b, 512)
 __CIPHER_DECLARE(SHA3, sha3, 256)
 
 
+// The hash builders append CBOR one token (typically 1-9 bytes) at a time.
+// The buffered variant gathers the appends and passes them to the hash engine
+// in whole blocks, saving a firmware call per token.
+// Small appends can be written straight into the buffer (_buffered_reserve and _buffered_commit).
+// Not used on Nano S where the additional RAM is not available.
+
+enum {
+	HASH_BUFFER_SIZE = 128, // BLAKE2b block size
+};
+
+#ifndef APP_XS
+
+#define __CIPHER_DECLARE_BUFFERED(cipher, bits) \
+	typedef struct { \
+		cipher##_##bits##_context_t hash; \
+		uint8_t buffer[HASH_BUFFER_SIZE]; \
+		uint8_t bufferSize; \
+	} cipher##_##bits##_buffered_context_t; \
+	\
+	static __attribute__((always_inline, unused)) void cipher##_##bits##_buffered_init( \
+	        cipher##_##bits##_buffered_context_t* ctx \
+	                                                                                  ) \
+	{ \
+		cipher##_##bits##_init(&ctx->hash); \
+		ctx->bufferSize = 0; \
+	} \
+	\
+	static __attribute__((unused)) void cipher##_##bits##_buffered_append( \
+	        cipher##_##bits##_buffered_context_t* ctx, \
+	        const uint8_t* inBuffer, size_t inSize \
+	                                                                    ) { \
+		ASSERT(ctx->hash.initialized_magic == HASH_CONTEXT_INITIALIZED_MAGIC); \
+		ASSERT(inSize < BUFFER_SIZE_PARANOIA); \
+		while (inSize > 0) { \
+			ASSERT(ctx->bufferSize < HASH_BUFFER_SIZE); \
+			const size_t chunkSize = MIN(inSize, (size_t) (HASH_BUFFER_SIZE - ctx->bufferSize)); \
+			memmove(ctx->buffer + ctx->bufferSize, inBuffer, chunkSize); \
+			ctx->bufferSize += chunkSize; \
+			inBuffer += chunkSize; \
+			inSize -= chunkSize; \
+			if (ctx->bufferSize == HASH_BUFFER_SIZE) { \
+				cipher##_##bits##_append(&ctx->hash, ctx->buffer, HASH_BUFFER_SIZE); \
+				ctx->bufferSize = 0; \
+			} \
+		} \
+	} \
+	\
+	/* space for writing up to maxSize bytes straight into the buffer, */ \
+	/* or the scratch buffer if the buffer does not have enough space left */ \
+	static __attribute__((unused)) uint8_t* cipher##_##bits##_buffered_reserve( \
+	        cipher##_##bits##_buffered_context_t* ctx, \
+	        uint8_t* scratch, size_t maxSize \
+	                                                                          ) { \
+		ASSERT(ctx->bufferSize < HASH_BUFFER_SIZE); \
+		if (maxSize <= (size_t) (HASH_BUFFER_SIZE - ctx->bufferSize)) { \
+			return ctx->buffer + ctx->bufferSize; \
+		} \
+		return scratch; \
+	} \
+	\
+	/* appends the size bytes written to the space given by _buffered_reserve */ \
+	static __attribute__((unused)) void cipher##_##bits##_buffered_commit( \
+	        cipher##_##bits##_buffered_context_t* ctx, \
+	        const uint8_t* written, size_t size \
+	                                                                    ) { \
+		if (written != ctx->buffer + ctx->bufferSize) { \
+			cipher##_##bits##_buffered_append(ctx, written, size); \
+			return; \
+		} \
+		ASSERT(size <= (size_t) (HASH_BUFFER_SIZE - ctx->bufferSize)); \
+		ctx->bufferSize += size; \
+		if (ctx->bufferSize == HASH_BUFFER_SIZE) { \
+			cipher##_##bits##_append(&ctx->hash, ctx->buffer, HASH_BUFFER_SIZE); \
+			ctx->bufferSize = 0; \
+		} \
+	} \
+	\
+	static __attribute__((unused)) void cipher##_##bits##_buffered_finalize( \
+	        cipher##_##bits##_buffered_context_t* ctx, \
+	        uint8_t* outBuffer, size_t outSize \
+	                                                                      ) { \
+		if (ctx->bufferSize > 0) { \
+			cipher##_##bits##_append(&ctx->hash, ctx->buffer, ctx->bufferSize); \
+			ctx->bufferSize = 0; \
+		} \
+		cipher##_##bits##_finalize(&ctx->hash, outBuffer, outSize); \
+	}
+
+#else
+
+// no buffer, the calls are passed directly to the plain context
+#define __CIPHER_DECLARE_BUFFERED(cipher, bits) \
+	typedef cipher##_##bits##_context_t cipher##_##bits##_buffered_context_t; \
+	\
+	static __attribute__((always_inline, unused)) void cipher##_##bits##_buffered_init( \
+	        cipher##_##bits##_buffered_context_t* ctx \
+	                                                                                  ) \
+	{ \
+		cipher##_##bits##_init(ctx); \
+	} \
+	\
+	static __attribute__((always_inline, unused)) void cipher##_##bits##_buffered_append( \
+	        cipher##_##bits##_buffered_context_t* ctx, \
+	        const uint8_t* inBuffer, size_t inSize \
+	                                                                                    ) { \
+		cipher##_##bits##_append(ctx, inBuffer, inSize); \
+	} \
+	\
+	static __attribute__((always_inline, unused)) uint8_t* cipher##_##bits##_buffered_reserve( \
+	        cipher##_##bits##_buffered_context_t* ctx MARK_UNUSED, \
+	        uint8_t* scratch, size_t maxSize MARK_UNUSED \
+	                                                                                          ) { \
+		return scratch; \
+	} \
+	\
+	static __attribute__((always_inline, unused)) void cipher##_##bits##_buffered_commit( \
+	        cipher##_##bits##_buffered_context_t* ctx, \
+	        const uint8_t* written, size_t size \
+	                                                                                    ) { \
+		cipher##_##bits##_append(ctx, written, size); \
+	} \
+	\
+	static __attribute__((always_inline, unused)) void cipher##_##bits##_buffered_finalize( \
+	        cipher##_##bits##_buffered_context_t* ctx, \
+	        uint8_t* outBuffer, size_t outSize \
+	                                                                                      ) { \
+		cipher##_##bits##_finalize(ctx, outBuffer, outSize); \
+	}
+
+#endif // APP_XS
+
+__CIPHER_DECLARE_BUFFERED(blake2b, 224)
+__CIPHER_DECLARE_BUFFERED(blake2b, 256)
+
+
 #ifdef DEVEL
 void run_hash_test();
 #endif // DEVEL
@@ -118,9 +118,98 @@ void run_blake2b_test()
 	}
 }
 
+// Sizes of the appends made by txHashBuilder for a simple tx body
+// with two inputs, two outputs, fee and ttl.
+static const uint8_t SIMPLE_TX_BODY_APPENDS[] = {
+	1, // map header
+	1, 1, // inputs key + array header
+	1, 2, 32, 1, // input (array header, bytes header, tx hash, index)
+	1, 2, 32, 1,
+	1, 1, // outputs key + array header
+	1, 1, 2, 57, 1, 9, // output (map header, key, bytes header, address, key, amount)
+	1, 1, 2, 57, 1, 9,
+	1, 5, // fee
+	1, 5, // ttl
+};
+
+// appends crossing the buffer boundary and longer than the buffer
+static const uint8_t LONG_APPENDS[] = {
+	127, 1, 1, 200, 128, 0, 64, 64, 255,
+};
+
+static void testcase_buffered_blake2b_256(
+        const char* name,
+        const uint8_t* appendSizes, size_t appendsCount
+)
+{
+	PRINTF("testcase_buffered_blake2b_256 %s\n", name);
+
+	uint8_t data[255] = {0};
+	for (size_t i = 0; i < SIZEOF(data); i++) {
+		data[i] = (uint8_t) (7 * i + 1);
+	}
+
+	uint8_t expectedBuffer[BLAKE2B_256_SIZE] = {0};
+	uint32_t unbufferedCalls = 0;
+	{
+		blake2b_256_context_t ctx;
+		hash_engineCallCount = 0;
+		blake2b_256_init(&ctx);
+		for (size_t i = 0; i < appendsCount; i++) {
+			blake2b_256_append(&ctx, data, appendSizes[i]);
+		}
+		blake2b_256_finalize(&ctx, expectedBuffer, SIZEOF(expectedBuffer));
+		unbufferedCalls = hash_engineCallCount;
+	}
+
+	uint8_t outputBuffer[BLAKE2B_256_SIZE] = {0};
+	uint32_t bufferedCalls = 0;
+	{
+		blake2b_256_buffered_context_t ctx;
+		hash_engineCallCount = 0;
+		blake2b_256_buffered_init(&ctx);
+		for (size_t i = 0; i < appendsCount; i++) {
+			blake2b_256_buffered_append(&ctx, data, appendSizes[i]);
+		}
+		blake2b_256_buffered_finalize(&ctx, outputBuffer, SIZEOF(outputBuffer));
+		bufferedCalls = hash_engineCallCount;
+	}
+
+	EXPECT_EQ_BYTES(expectedBuffer, outputBuffer, SIZEOF(expectedBuffer));
+
+	PRINTF("hash engine calls: %u unbuffered, %u buffered\n", unbufferedCalls, bufferedCalls);
+	EXPECT_EQ(bufferedCalls <= unbufferedCalls, true);
+
+	// the same appends written straight into the buffer
+	uint8_t reservedOutputBuffer[BLAKE2B_256_SIZE] = {0};
+	{
+		blake2b_256_buffered_context_t ctx;
+		hash_engineCallCount = 0;
+		blake2b_256_buffered_init(&ctx);
+		for (size_t i = 0; i < appendsCount; i++) {
+			uint8_t scratch[SIZEOF(data)] = {0};
+			uint8_t* space = blake2b_256_buffered_reserve(&ctx, scratch, appendSizes[i]);
+			memmove(space, data, appendSizes[i]);
+			blake2b_256_buffered_commit(&ctx, space, appendSizes[i]);
+		}
+		blake2b_256_buffered_finalize(&ctx, reservedOutputBuffer, SIZEOF(reservedOutputBuffer));
+		EXPECT_EQ(hash_engineCallCount, bufferedCalls);
+	}
+
+	EXPECT_EQ_BYTES(expectedBuffer, reservedOutputBuffer, SIZEOF(expectedBuffer));
+}
+
+void run_buffered_hash_test()
+{
+	testcase_buffered_blake2b_256("empty", NULL, 0);
+	testcase_buffered_blake2b_256("simple tx body", SIMPLE_TX_BODY_APPENDS, ARRAY_LEN(SIMPLE_TX_BODY_APPENDS));
+	testcase_buffered_blake2b_256("long appends", LONG_APPENDS, ARRAY_LEN(LONG_APPENDS));
+}
+
 void run_hash_test()
 {
 	run_blake2b_test();
+	run_buffered_hash_test();
 }
 
 #endif // DEVEL
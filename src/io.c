@@ -1,6 +1,7 @@
 #include "io.h"
 #include "common.h"
 #include "ui.h"
+#include "signTxSession.h"
 
 io_state_t io_state;
 
@@ -128,6 +129,9 @@ unsigned char io_event(unsigned char channel MARK_UNUSED)
 		#endif // HAVE_NBGL
 
 	case SEPROXYHAL_TAG_TICKER_EVENT:
+		#ifdef APP_FEATURE_SIGN_TX_SESSION
+		signTxSession_tick();
+		#endif // APP_FEATURE_SIGN_TX_SESSION
 		UX_TICKER_EVENT(G_io_seproxyhal_spi_buffer, {
 			TRACE("timer");
 			HANDLE_UX_TICKER_EVENT(UX_ALLOWED);
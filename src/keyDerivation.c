@@ -12,9 +12,10 @@
 #include "cardano.h"
 #include "securityPolicy.h"
 #include "crypto.h"
+#include "perfCounters.h"
 
 static void extractRawPublicKey(
-        uint8_t rawPubkey[static 65],
+        const uint8_t rawPubkey[static 65],
         uint8_t* outBuffer, size_t outSize
 )
 {
@@ -32,22 +33,178 @@ static void extractRawPublicKey(
 }
 
 
-// pub_key + chain_code
-void deriveExtendedPublicKey(
+#ifdef APP_FEATURE_ACCOUNT_NODE_CACHE
+
+// Ed25519 base point in the uncompressed format used by cx_ecfp_* (04 || x || y, big endian)
+static const uint8_t ED25519_BASE_POINT[65] = {
+	0x04,
+	0x21, 0x69, 0x36, 0xd3, 0xcd, 0x6e, 0x53, 0xfe, 0xc0, 0xa4, 0xe2, 0x31, 0xfd, 0xd6, 0xdc, 0x5c,
+	0x69, 0x2c, 0xc7, 0x60, 0x95, 0x25, 0xa7, 0xb2, 0xc9, 0x56, 0x2d, 0x60, 0x8f, 0x25, 0xd5, 0x1a,
+	0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+	0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x58,
+};
+
+// The last derived node whose path consists of hardened indices only
+// (typically an account). Its non-hardened descendants are derived
+// from the public key, avoiding the derivation from the seed.
+// Only public data are stored, the cache is reset with each new instruction.
+static struct {
+	bool isValid;
+	bip44_path_t pathSpec;
+	uint8_t rawPubkey[65];
+	uint8_t chainCode[CHAIN_CODE_SIZE];
+} accountNodeCache;
+
+void keyDerivation_resetCache()
+{
+	explicit_bzero(&accountNodeCache, SIZEOF(accountNodeCache));
+}
+
+// BIP32-Ed25519 public child key derivation (V2 scheme, as used by Cardano)
+//   Z = HMAC-SHA512(c, 0x02 || A || LE32(index))
+//   A_child = A + [8 * Z[0:28]] B
+//   c_child = HMAC-SHA512(c, 0x03 || A || LE32(index))[32:64]
+static cx_err_t deriveSoftChild(
+        const uint8_t parentRawPubkey[static 65],
+        const uint8_t parentChainCode[static CHAIN_CODE_SIZE],
+        uint32_t index,
+        uint8_t rawPubkey[static 65],
+        uint8_t chainCode[static CHAIN_CODE_SIZE]
+)
+{
+	ASSERT((index & HARDENED_BIP32) == 0);
+	PERF_COUNTERS_ADD(softDerivations, 1);
+
+	cx_err_t error = CX_OK;
+	cx_hmac_sha512_t hmac;
+	uint8_t z[64];
+	uint8_t scalar[32];
+	uint8_t point[65];
+
+	uint8_t parentPubkey[PUBLIC_KEY_SIZE];
+	extractRawPublicKey(parentRawPubkey, parentPubkey, SIZEOF(parentPubkey));
+
+	// unlike in BIP32, the index is serialized as little endian
+	uint8_t indexLE[4];
+	for (size_t i = 0; i < 4; i++) {
+		indexLE[i] = (uint8_t) (index >> (8 * i));
+	}
+
+	const uint8_t tagPubkey = 0x02;
+	const uint8_t tagChainCode = 0x03;
+
+	// Z
+	CX_CHECK(cx_hmac_sha512_init_no_throw(&hmac, parentChainCode, CHAIN_CODE_SIZE));
+	CX_CHECK(cx_hmac_update((cx_hmac_t*) &hmac, &tagPubkey, 1));
+	CX_CHECK(cx_hmac_update((cx_hmac_t*) &hmac, parentPubkey, SIZEOF(parentPubkey)));
+	CX_CHECK(cx_hmac_update((cx_hmac_t*) &hmac, indexLE, 4));
+	size_t zSize = SIZEOF(z);
+	CX_CHECK(cx_hmac_final((cx_hmac_t*) &hmac, z, &zSize));
+
+	// 8 * Z[0:28], converted from little endian to big endian (as expected by cx_ecfp_*)
+	{
+		uint8_t carry = 0;
+		for (size_t i = 0; i < SIZEOF(scalar); i++) {
+			const uint8_t byte = (i < 28) ? z[i] : 0;
+			scalar[SIZEOF(scalar) - 1 - i] = (uint8_t) ((byte << 3) | carry);
+			carry = byte >> 5;
+		}
+		ASSERT(carry == 0);
+	}
+
+	// A_child
+	memmove(point, ED25519_BASE_POINT, SIZEOF(point));
+	CX_CHECK(cx_ecfp_scalar_mult_no_throw(CX_CURVE_Ed25519, point, scalar, SIZEOF(scalar)));
+	CX_CHECK(cx_ecfp_add_point_no_throw(CX_CURVE_Ed25519, rawPubkey, point, parentRawPubkey));
+
+	// c_child
+	CX_CHECK(cx_hmac_sha512_init_no_throw(&hmac, parentChainCode, CHAIN_CODE_SIZE));
+	CX_CHECK(cx_hmac_update((cx_hmac_t*) &hmac, &tagChainCode, 1));
+	CX_CHECK(cx_hmac_update((cx_hmac_t*) &hmac, parentPubkey, SIZEOF(parentPubkey)));
+	CX_CHECK(cx_hmac_update((cx_hmac_t*) &hmac, indexLE, 4));
+	zSize = SIZEOF(z);
+	CX_CHECK(cx_hmac_final((cx_hmac_t*) &hmac, z, &zSize));
+	memmove(chainCode, z + CHAIN_CODE_SIZE, CHAIN_CODE_SIZE);
+
+end:
+	explicit_bzero(&hmac, SIZEOF(hmac));
+	explicit_bzero(z, SIZEOF(z));
+	explicit_bzero(scalar, SIZEOF(scalar));
+	return error;
+}
+
+// number of leading hardened indices in the path
+static size_t hardenedPrefixLength(const bip44_path_t* pathSpec)
+{
+	size_t length = 0;
+	while (length < pathSpec->length && (pathSpec->path[length] & HARDENED_BIP32) != 0) {
+		length++;
+	}
+	return length;
+}
+
+static bool containsHardenedIndexFrom(const bip44_path_t* pathSpec, size_t start)
+{
+	for (size_t i = start; i < pathSpec->length; i++) {
+		if ((pathSpec->path[i] & HARDENED_BIP32) != 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+#endif // APP_FEATURE_ACCOUNT_NODE_CACHE
+
+static void deriveRawPublicKey(
         const bip44_path_t* pathSpec,
-        extendedPublicKey_t* out
+        uint8_t rawPubkey[static 65],
+        uint8_t chainCode[static CHAIN_CODE_SIZE]
 )
 {
-	uint8_t rawPubkey[65];
-	uint8_t chainCode[CHAIN_CODE_SIZE];
+	#ifdef APP_FEATURE_ACCOUNT_NODE_CACHE
+	// a path is split into its hardened prefix (at least up to the account)
+	// and the non-hardened rest, derived from the public key of the prefix
+	const size_t prefixLength = hardenedPrefixLength(pathSpec);
+	if (prefixLength >= 3 && !containsHardenedIndexFrom(pathSpec, prefixLength)) {
+		bip44_path_t prefix = {0};
+		prefix.length = prefixLength;
+		for (size_t i = 0; i < prefixLength; i++) {
+			prefix.path[i] = pathSpec->path[i];
+		}
 
-	STATIC_ASSERT(SIZEOF(*out) == CHAIN_CODE_SIZE + PUBLIC_KEY_SIZE, "bad ext pub key size");
+		if (!accountNodeCache.isValid || !bip44_pathsEqual(&accountNodeCache.pathSpec, &prefix)) {
+			TRACE("Account node cache miss");
+			accountNodeCache.isValid = false;
+			cx_err_t error = crypto_get_pubkey(prefix.path,
+			                                   prefix.length,
+			                                   accountNodeCache.rawPubkey,
+			                                   accountNodeCache.chainCode);
+			if (error != CX_OK) {
+				PRINTF("error: %d", error);
+				ASSERT(false);
+			}
+			accountNodeCache.pathSpec = prefix;
+			accountNodeCache.isValid = true;
+		}
 
-	// Sanity check
-	ASSERT(pathSpec->length <= ARRAY_LEN(pathSpec->path));
+		memmove(rawPubkey, accountNodeCache.rawPubkey, SIZEOF(accountNodeCache.rawPubkey));
+		memmove(chainCode, accountNodeCache.chainCode, SIZEOF(accountNodeCache.chainCode));
 
-	// if the path is invalid, it's a bug in previous validation
-	ASSERT(policyForDerivePrivateKey(pathSpec) != POLICY_DENY);
+		for (size_t i = prefixLength; i < pathSpec->length; i++) {
+			uint8_t childRawPubkey[65];
+			uint8_t childChainCode[CHAIN_CODE_SIZE];
+			cx_err_t error = deriveSoftChild(rawPubkey, chainCode, pathSpec->path[i],
+			                                 childRawPubkey, childChainCode);
+			if (error != CX_OK) {
+				PRINTF("error: %d", error);
+				ASSERT(false);
+			}
+			memmove(rawPubkey, childRawPubkey, SIZEOF(childRawPubkey));
+			memmove(chainCode, childChainCode, SIZEOF(childChainCode));
+		}
+		return;
+	}
+	#endif // APP_FEATURE_ACCOUNT_NODE_CACHE
 
 	{
 		cx_err_t error = crypto_get_pubkey(pathSpec->path,
@@ -59,6 +216,26 @@ void deriveExtendedPublicKey(
 			ASSERT(false);
 		}
 	}
+}
+
+// pub_key + chain_code
+void deriveExtendedPublicKey(
+        const bip44_path_t* pathSpec,
+        extendedPublicKey_t* out
+)
+{
+	uint8_t rawPubkey[65];
+	uint8_t chainCode[CHAIN_CODE_SIZE];
+
+	STATIC_ASSERT(SIZEOF(*out) == CHAIN_CODE_SIZE + PUBLIC_KEY_SIZE, "bad ext pub key size");
+
+	// Sanity check
+	ASSERT(pathSpec->length <= ARRAY_LEN(pathSpec->path));
+
+	// if the path is invalid, it's a bug in previous validation
+	ASSERT(policyForDerivePrivateKey(pathSpec) != POLICY_DENY);
+
+	deriveRawPublicKey(pathSpec, rawPubkey, chainCode);
 
 	extractRawPublicKey(rawPubkey, out->pubKey, SIZEOF(out->pubKey));
 
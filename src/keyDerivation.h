@@ -26,6 +26,10 @@ void deriveExtendedPublicKey(
         extendedPublicKey_t* out
 );
 
+#ifdef APP_FEATURE_ACCOUNT_NODE_CACHE
+void keyDerivation_resetCache();
+#endif // APP_FEATURE_ACCOUNT_NODE_CACHE
+
 
 #ifdef DEVEL
 void run_key_derivation_test();
@@ -3,6 +3,7 @@
 #include "keyDerivation.h"
 #include "hexUtils.h"
 #include "testUtils.h"
+#include "crypto.h"
 
 static void pathSpec_init(bip44_path_t* pathSpec, const uint32_t* pathArray, uint32_t pathLength)
 {
@@ -72,6 +73,67 @@ void testPublicKeyDerivation()
 #undef TESTCASE
 }
 
+#ifdef APP_FEATURE_ACCOUNT_NODE_CACHE
+
+// the result of derivation from the public key of the account
+// must match derivation of the whole path from the seed
+void testcase_softDerivation(uint32_t* path, uint32_t pathLen)
+{
+	PRINTF("testcase_softDerivation ");
+
+	bip44_path_t pathSpec;
+	pathSpec_init(&pathSpec, path, pathLen);
+
+	BIP44_PRINTF(&pathSpec);
+	PRINTF("\n");
+
+	uint8_t rawPubkey[65] = {0};
+	uint8_t chainCode[CHAIN_CODE_SIZE] = {0};
+	EXPECT_EQ(crypto_get_pubkey(path, pathLen, rawPubkey, chainCode), CX_OK);
+
+	uint8_t expectedPubKey[PUBLIC_KEY_SIZE] = {0};
+	for (size_t i = 0; i < PUBLIC_KEY_SIZE; i++) {
+		expectedPubKey[i] = rawPubkey[64 - i];
+	}
+	if ((rawPubkey[32] & 1) != 0) {
+		expectedPubKey[31] |= 0x80;
+	}
+
+	keyDerivation_resetCache();
+
+	// the first derivation fills the cache, the second one uses it
+	for (int i = 0; i < 2; i++) {
+		extendedPublicKey_t extPubKey;
+		deriveExtendedPublicKey(&pathSpec, &extPubKey);
+
+		EXPECT_EQ_BYTES(expectedPubKey, extPubKey.pubKey, SIZEOF(expectedPubKey));
+		EXPECT_EQ_BYTES(chainCode, extPubKey.chainCode, SIZEOF(chainCode));
+	}
+}
+
+void testSoftDerivation()
+{
+#define TESTCASE(path_) \
+	{ \
+		uint32_t path[] = { UNWRAP path_ }; \
+		testcase_softDerivation(path, ARRAY_LEN(path)); \
+	}
+
+	TESTCASE((HD + 44, HD + 1815, HD + 1, 0, 55));
+	TESTCASE((HD + 1852, HD + 1815, HD + 0, 0, 0));
+	TESTCASE((HD + 1852, HD + 1815, HD + 0, 1, 189));
+	TESTCASE((HD + 1852, HD + 1815, HD + 0, 2, 0));
+	TESTCASE((HD + 1852, HD + 1815, HD + 0, 0, 0x7fffffff));
+	TESTCASE((HD + 1854, HD + 1815, HD + 3, 0, 7));
+	// hardened index below a soft one, derived from the seed
+	TESTCASE((HD + 1852, HD + 1815, HD + 0, 0, HD + 1));
+
+#undef TESTCASE
+
+	keyDerivation_resetCache();
+}
+
+#endif // APP_FEATURE_ACCOUNT_NODE_CACHE
 
 void run_key_derivation_test()
 {
@@ -79,6 +141,9 @@ void run_key_derivation_test()
 	PRINTF("If they fail, make sure you seeded your device with\n");
 	PRINTF("12-word mnemonic: 11*abandon about\n");
 	testPublicKeyDerivation();
+	#ifdef APP_FEATURE_ACCOUNT_NODE_CACHE
+	testSoftDerivation();
+	#endif // APP_FEATURE_ACCOUNT_NODE_CACHE
 }
 
 #endif // DEVEL
@@ -0,0 +1,42 @@
+#ifdef APP_FEATURE_KEY_HASH_CACHE
+
+#include "keyHashCache.h"
+
+void keyHashCache_pathToKeyHash(
+        key_hash_cache_t* cache,
+        const bip44_path_t* pathSpec,
+        uint8_t* hash, size_t hashSize
+)
+{
+	ASSERT(cache->numEntries <= KEY_HASH_CACHE_SIZE);
+	ASSERT(hashSize == ADDRESS_KEY_HASH_LENGTH);
+
+	key_hash_cache_entry_t entry;
+
+	size_t i = 0;
+	while (i < cache->numEntries && !bip44_pathsEqual(&cache->entries[i].path, pathSpec)) {
+		i++;
+	}
+
+	if (i < cache->numEntries) {
+		entry = cache->entries[i];
+	} else {
+		entry.path = *pathSpec;
+		bip44_pathToKeyHash(pathSpec, entry.keyHash, SIZEOF(entry.keyHash));
+
+		if (cache->numEntries < KEY_HASH_CACHE_SIZE) {
+			cache->numEntries++;
+		}
+		// the least recently used entry is dropped if the cache is full
+		i = cache->numEntries - 1;
+	}
+
+	// move the entry to the front
+	memmove(&cache->entries[1], &cache->entries[0], i * SIZEOF(cache->entries[0]));
+	cache->entries[0] = entry;
+
+	STATIC_ASSERT(SIZEOF(entry.keyHash) == ADDRESS_KEY_HASH_LENGTH, "wrong key hash size");
+	memmove(hash, entry.keyHash, hashSize);
+}
+
+#endif // APP_FEATURE_KEY_HASH_CACHE
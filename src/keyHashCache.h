@@ -0,0 +1,39 @@
+#ifndef H_CARDANO_APP_KEY_HASH_CACHE
+#define H_CARDANO_APP_KEY_HASH_CACHE
+
+#include "common.h"
+#include "cardano.h"
+#include "bip44.h"
+
+#ifdef APP_FEATURE_KEY_HASH_CACHE
+
+// a staking key typically appears in several certificates,
+// a withdrawal, a vote and an output address of a single tx
+#define KEY_HASH_CACHE_SIZE 4
+
+typedef struct {
+	bip44_path_t path;
+	uint8_t keyHash[ADDRESS_KEY_HASH_LENGTH];
+} key_hash_cache_entry_t;
+
+// Key hashes of the recently used paths, the most recently used first.
+// Only public data are stored. A zeroed struct is an empty cache.
+typedef struct {
+	key_hash_cache_entry_t entries[KEY_HASH_CACHE_SIZE];
+	size_t numEntries;
+} key_hash_cache_t;
+
+// same as bip44_pathToKeyHash, derives the key only if the path is not cached
+void keyHashCache_pathToKeyHash(
+        key_hash_cache_t* cache,
+        const bip44_path_t* pathSpec,
+        uint8_t* hash, size_t hashSize
+);
+
+#ifdef DEVEL
+void run_keyHashCache_test();
+#endif // DEVEL
+
+#endif // APP_FEATURE_KEY_HASH_CACHE
+
+#endif // H_CARDANO_APP_KEY_HASH_CACHE
@@ -0,0 +1,119 @@
+#ifdef DEVEL
+
+#include "keyHashCache.h"
+#include "testUtils.h"
+
+#ifdef APP_FEATURE_KEY_HASH_CACHE
+
+#define HD HARDENED_BIP32
+
+static void pathSpec_init(bip44_path_t* pathSpec, uint32_t lastIndex)
+{
+	const uint32_t path[] = {HD + 1852, HD + 1815, HD + 0, 2, lastIndex};
+	pathSpec->length = ARRAY_LEN(path);
+	memmove(pathSpec->path, path, SIZEOF(path));
+}
+
+// looks up m/1852'/1815'/0'/2/lastIndex and checks the result against the uncached key hash
+static void testcase_lookup(key_hash_cache_t* cache, uint32_t lastIndex)
+{
+	PRINTF("testcase_keyHashCache_lookup %u\n", (unsigned) lastIndex);
+
+	bip44_path_t pathSpec;
+	pathSpec_init(&pathSpec, lastIndex);
+
+	uint8_t expected[ADDRESS_KEY_HASH_LENGTH] = {0};
+	bip44_pathToKeyHash(&pathSpec, expected, SIZEOF(expected));
+
+	uint8_t keyHash[ADDRESS_KEY_HASH_LENGTH] = {0};
+	keyHashCache_pathToKeyHash(cache, &pathSpec, keyHash, SIZEOF(keyHash));
+
+	EXPECT_EQ_BYTES(expected, keyHash, SIZEOF(expected));
+	// the path becomes the most recently used one
+	EXPECT_EQ(bip44_pathsEqual(&cache->entries[0].path, &pathSpec), true);
+}
+
+// the cached paths, the most recently used first
+static void expectCachedPaths(const key_hash_cache_t* cache, const uint32_t* lastIndices, size_t count)
+{
+	EXPECT_EQ(cache->numEntries, count);
+	for (size_t i = 0; i < count; i++) {
+		bip44_path_t pathSpec;
+		pathSpec_init(&pathSpec, lastIndices[i]);
+		EXPECT_EQ(bip44_pathsEqual(&cache->entries[i].path, &pathSpec), true);
+	}
+}
+
+static void testLeastRecentlyUsedEviction()
+{
+	STATIC_ASSERT(KEY_HASH_CACHE_SIZE == 4, "update the expected cache contents");
+
+	key_hash_cache_t cache;
+	explicit_bzero(&cache, SIZEOF(cache));
+
+#define EXPECT_CACHED(...) \
+	{ \
+		const uint32_t lastIndices[] = { __VA_ARGS__ }; \
+		expectCachedPaths(&cache, lastIndices, ARRAY_LEN(lastIndices)); \
+	}
+
+	testcase_lookup(&cache, 0);
+	testcase_lookup(&cache, 1);
+	testcase_lookup(&cache, 0);
+	EXPECT_CACHED(0, 1);
+
+	testcase_lookup(&cache, 2);
+	testcase_lookup(&cache, 3);
+	EXPECT_CACHED(3, 2, 0, 1);
+
+	// a hit in the middle
+	testcase_lookup(&cache, 2);
+	EXPECT_CACHED(2, 3, 0, 1);
+
+	// 1 is the least recently used one
+	testcase_lookup(&cache, 4);
+	EXPECT_CACHED(4, 2, 3, 0);
+
+	// a hit at the end
+	testcase_lookup(&cache, 0);
+	EXPECT_CACHED(0, 4, 2, 3);
+
+	testcase_lookup(&cache, 1);
+	EXPECT_CACHED(1, 0, 4, 2);
+
+#undef EXPECT_CACHED
+}
+
+static void testPathLengths()
+{
+	key_hash_cache_t cache;
+	explicit_bzero(&cache, SIZEOF(cache));
+
+	// a prefix of a cached path is a different path
+	bip44_path_t account;
+	pathSpec_init(&account, 0);
+	account.length = 3;
+
+	testcase_lookup(&cache, 0);
+
+	uint8_t expected[ADDRESS_KEY_HASH_LENGTH] = {0};
+	bip44_pathToKeyHash(&account, expected, SIZEOF(expected));
+	uint8_t keyHash[ADDRESS_KEY_HASH_LENGTH] = {0};
+	keyHashCache_pathToKeyHash(&cache, &account, keyHash, SIZEOF(keyHash));
+
+	EXPECT_EQ_BYTES(expected, keyHash, SIZEOF(expected));
+	EXPECT_EQ(cache.numEntries, 2);
+}
+
+#undef HD
+
+void run_keyHashCache_test()
+{
+	PRINTF("Running key hash cache tests\n");
+	testLeastRecentlyUsedEviction();
+	testPathLengths();
+}
+
+#endif // APP_FEATURE_KEY_HASH_CACHE
+
+#endif // DEVEL
@@ -32,6 +32,7 @@
 #include "menu.h"
 #include "assert.h"
 #include "io.h"
+#include "signTxSession.h"
 
 #ifdef HAVE_BAGL
 #include "uiScreens_bagl.h"
@@ -39,10 +40,6 @@
 #include "uiScreens_nbgl.h"
 #endif
 
-static const int INS_NONE = -1;
-
-static const uint8_t CLA = 0xD7;
-
 // This is the main loop that reads and writes APDUs. It receives request
 // APDUs from the computer, looks up the corresponding command handler, and
 // calls it on the APDU payload. Then it loops around and calls io_exchange
@@ -86,52 +83,7 @@ static void cardano_main(void)
 
 				VALIDATE(device_is_unlocked(), ERR_DEVICE_LOCKED);
 
-				// Note(ppershing): unsafe to access before checks
-				// Warning(ppershing): in case of unlikely change of APDU format
-				// make sure you read wider values as big endian
-				struct {
-					uint8_t cla;
-					uint8_t ins;
-					uint8_t p1;
-					uint8_t p2;
-					uint8_t lc;
-				}* header = (void*) G_io_apdu_buffer;
-
-				VALIDATE(rx >= SIZEOF(*header), ERR_MALFORMED_REQUEST_HEADER);
-
-				// check that data is safe to access
-				VALIDATE(rx == header->lc + SIZEOF(*header), ERR_MALFORMED_REQUEST_HEADER);
-
-				uint8_t* data = G_io_apdu_buffer + SIZEOF(*header);
-
-				VALIDATE(header->cla == CLA, ERR_BAD_CLA);
-
-				TRACE("APDU: ins = %d,   p1 = %d,    p2 = %d", header->ins, header->p1, header->p2);
-
-				// Lookup and call the requested command handler.
-				handler_fn_t* handlerFn = lookupHandler(header->ins);
-
-				VALIDATE(handlerFn != NULL, ERR_UNKNOWN_INS);
-
-				bool isNewCall = false;
-				if (currentInstruction == INS_NONE)
-				{
-					explicit_bzero(&instructionState, SIZEOF(instructionState));
-					isNewCall = true;
-					currentInstruction = header->ins;
-				} else
-				{
-					VALIDATE(header->ins == currentInstruction, ERR_STILL_IN_CALL);
-				}
-
-
-				// Note: handlerFn is responsible for calling io_send
-				// either during its call or subsequent UI actions
-				handlerFn(header->p1,
-				          header->p2,
-				          data,
-				          header->lc,
-				          isNewCall);
+				handleApdu(G_io_apdu_buffer, rx);
 				flags = IO_ASYNCH_REPLY;
 			}
 			CATCH(EXCEPTION_IO_RESET)
@@ -140,6 +92,7 @@ static void cardano_main(void)
 			}
 			CATCH(ERR_ASSERT)
 			{
+				explicit_bzero(&instructionState, SIZEOF(instructionState));
 				// Note(ppershing): assertions should not auto-respond
 				#ifdef RESET_ON_CRASH
 				// Reset device
@@ -148,6 +101,8 @@ static void cardano_main(void)
 			}
 			CATCH_OTHER(e)
 			{
+				// an aborted instruction leaves nothing behind
+				explicit_bzero(&instructionState, SIZEOF(instructionState));
 				if (e >= _ERR_AUTORESPOND_START && e < _ERR_AUTORESPOND_END) {
 					io_send_buf(e, NULL, 0);
 					flags = IO_ASYNCH_REPLY;
@@ -229,6 +184,11 @@ __attribute__((section(".boot"))) int main(void)
 			}
 			CATCH(EXCEPTION_IO_RESET)
 			{
+				explicit_bzero(&instructionState, SIZEOF(instructionState));
+				#ifdef APP_FEATURE_SIGN_TX_SESSION
+				// the host which opened the session is gone
+				signTxSession_close();
+				#endif // APP_FEATURE_SIGN_TX_SESSION
 				// reset IO and UX before continuing
 				CLOSE_TRY;
 				continue;
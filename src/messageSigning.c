@@ -21,7 +21,7 @@ void signRawMessageWithPath(bip44_path_t* pathSpec,
 	// if the path is invalid, it's a bug in previous validation
 	ASSERT(policyForDerivePrivateKey(pathSpec) != POLICY_DENY);
 
-	#ifndef FUZZING
+	#if !defined(FUZZING) || defined(NATIVE_CRYPTO)
 	{
 		TRACE("signing with path:");
 		BIP44_PRINTF(pathSpec);
@@ -50,7 +50,7 @@ void getWitness(bip44_path_t* pathSpec,
 {
 	ASSERT(outSize < BUFFER_SIZE_PARANOIA);
 
-	#ifndef FUZZING
+	#if !defined(FUZZING) || defined(NATIVE_CRYPTO)
 	signRawMessageWithPath(pathSpec, hashBuffer, hashSize, outBuffer, outSize);
 	#endif
 }
@@ -62,7 +62,7 @@ void getCVoteRegistrationSignature(bip44_path_t* pathSpec,
 	ASSERT(payloadHashSize == CVOTE_REGISTRATION_PAYLOAD_HASH_LENGTH);
 	ASSERT(outSize < BUFFER_SIZE_PARANOIA);
 
-	#ifndef FUZZING
+	#if !defined(FUZZING) || defined(NATIVE_CRYPTO)
 	signRawMessageWithPath(pathSpec, payloadHashBuffer, payloadHashSize, outBuffer, outSize);
 	#endif
 }
@@ -15,7 +15,7 @@ typedef struct {
 	uint8_t level;
 	uint32_t remainingScripts[MAX_SCRIPT_DEPTH];
 	native_script_hash_builder_state_t state;
-	blake2b_224_context_t nativeScriptHash;
+	blake2b_224_buffered_context_t nativeScriptHash;
 } native_script_hash_builder_t;
 
 void nativeScriptHashBuilder_init(
@@ -0,0 +1,87 @@
+#ifdef DEVEL
+
+#include "perfCounters.h"
+#include "endian.h"
+#include "uiHelpers.h"
+
+// see handlers.c
+#define INS_GET_PERF_COUNTERS 0xF2
+
+perf_counters_t perfCounters;
+
+// the last finished instruction
+static perf_counters_t lastPerfCounters;
+
+static int currentStackPosition()
+{
+	volatile uint32_t x = 0;
+	return (int) ((void*) &x - (void*) &app_stack_canary);
+}
+
+void perfCounters_startInstruction(uint8_t ins)
+{
+	// reading the counters must not overwrite them
+	if (perfCounters.apdus > 0 && perfCounters.ins != INS_GET_PERF_COUNTERS) {
+		lastPerfCounters = perfCounters;
+	}
+
+	explicit_bzero(&perfCounters, SIZEOF(perfCounters));
+	perfCounters.ins = ins;
+	perfCounters.stackStart = currentStackPosition();
+	perfCounters.stackLowest = perfCounters.stackStart;
+}
+
+// called by TRACE_STACK_USAGE
+void perfCounters_recordStackPosition(int position)
+{
+	if (position < perfCounters.stackLowest) {
+		perfCounters.stackLowest = position;
+	}
+}
+
+void perfCounters_handleAPDU(
+        uint8_t p1,
+        uint8_t p2,
+        const uint8_t* wireDataBuffer MARK_UNUSED,
+        size_t wireDataSize,
+        bool isNewCall MARK_UNUSED
+)
+{
+	VALIDATE(p1 == P1_UNUSED, ERR_INVALID_REQUEST_PARAMETERS);
+	VALIDATE(p2 == P2_UNUSED, ERR_INVALID_REQUEST_PARAMETERS);
+	VALIDATE(wireDataSize == 0, ERR_INVALID_DATA);
+
+	const perf_counters_t* counters = &lastPerfCounters;
+
+	struct {
+		uint8_t ins;
+		uint8_t apdus[4];
+		uint8_t hashedBytesBlake2b[4];
+		uint8_t hashedBytesSha3[4];
+		uint8_t derivations[4];
+		uint8_t softDerivations[4];
+		uint8_t signatures[4];
+		uint8_t uiScreens[4];
+		// the deepest TRACE_STACK_USAGE below the start of the instruction
+		uint8_t stackDepth[4];
+		// the smallest distance from the stack canary seen by TRACE_STACK_USAGE
+		uint8_t stackHeadroom[4];
+	} response;
+	explicit_bzero(&response, SIZEOF(response));
+
+	response.ins = counters->ins;
+	u4be_write(response.apdus, counters->apdus);
+	u4be_write(response.hashedBytesBlake2b, counters->hashedBytes[PERF_HASH_BLAKE2B]);
+	u4be_write(response.hashedBytesSha3, counters->hashedBytes[PERF_HASH_SHA3]);
+	u4be_write(response.derivations, counters->derivations);
+	u4be_write(response.softDerivations, counters->softDerivations);
+	u4be_write(response.signatures, counters->signatures);
+	u4be_write(response.uiScreens, counters->uiScreens);
+	u4be_write(response.stackDepth, (uint32_t) (counters->stackStart - counters->stackLowest));
+	u4be_write(response.stackHeadroom, (uint32_t) MAX(counters->stackLowest, 0));
+
+	io_send_buf(SUCCESS, (uint8_t*) &response, SIZEOF(response));
+	ui_idle();
+}
+
+#endif // DEVEL
@@ -0,0 +1,50 @@
+#ifndef H_CARDANO_APP_PERF_COUNTERS
+#define H_CARDANO_APP_PERF_COUNTERS
+
+#include "common.h"
+
+// Costs of an instruction (APDUs, hashing, key derivations, signatures, UI),
+// gathered in DEVEL builds and returned by INS_GET_PERF_COUNTERS
+// for the last finished instruction.
+
+#ifdef DEVEL
+
+#include "handlers.h"
+
+typedef enum {
+	PERF_HASH_BLAKE2B = 0,
+	PERF_HASH_SHA3 = 1,
+	PERF_HASH_TYPES_COUNT
+} perf_hash_type_t;
+
+typedef struct {
+	uint8_t ins;
+	uint32_t apdus;
+	uint32_t hashedBytes[PERF_HASH_TYPES_COUNT];
+	uint32_t derivations; // from the seed
+	uint32_t softDerivations; // from a cached account node
+	uint32_t signatures;
+	uint32_t uiScreens;
+
+	// stack positions (distance from app_stack_canary), see TRACE_STACK_USAGE
+	int stackStart;
+	int stackLowest;
+} perf_counters_t;
+
+// the instruction in progress
+extern perf_counters_t perfCounters;
+
+#define PERF_COUNTERS_ADD(FIELD, N) (perfCounters.FIELD += (N))
+
+// to be called when a new instruction starts
+void perfCounters_startInstruction(uint8_t ins);
+
+handler_fn_t perfCounters_handleAPDU;
+
+#else
+
+#define PERF_COUNTERS_ADD(FIELD, N)
+
+#endif // DEVEL
+
+#endif // H_CARDANO_APP_PERF_COUNTERS
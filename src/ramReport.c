@@ -0,0 +1,45 @@
+#ifdef RAM_REPORT
+
+// Not part of the app; compiled only by `make ram_report`.
+// Every variable below has the size of one RAM-resident type,
+// the report target lists them via nm and strips the prefixes.
+// The budgets checked on every build are in state.c.
+
+#include "state.h"
+#include "uiHelpers.h"
+
+#define REPORT_TYPE(TYPE) TYPE ramReport_##TYPE
+#define REPORT_MEMBER(MEMBER) __typeof__(instructionState.MEMBER) ramReport_instructionState__##MEMBER
+
+REPORT_TYPE(instructionState_t);
+REPORT_MEMBER(getKeysContext);
+REPORT_MEMBER(deriveAddressContext);
+#ifdef APP_FEATURE_NATIVE_SCRIPT_HASH
+REPORT_MEMBER(deriveNativeScriptHashContext);
+#endif // APP_FEATURE_NATIVE_SCRIPT_HASH
+REPORT_MEMBER(signTxContext);
+#ifdef APP_FEATURE_OPCERT
+REPORT_MEMBER(signOpCertContext);
+#endif // APP_FEATURE_OPCERT
+REPORT_MEMBER(signCVoteContext);
+REPORT_MEMBER(signMsgContext);
+
+// the parts of the sign tx context
+REPORT_TYPE(common_tx_data_t);
+REPORT_TYPE(ins_sign_tx_aux_data_context_t);
+REPORT_TYPE(ins_sign_tx_body_context_t);
+REPORT_TYPE(ins_sign_tx_witness_context_t);
+REPORT_TYPE(cvote_registration_context_t);
+#ifdef APP_FEATURE_POOL_REGISTRATION
+REPORT_TYPE(pool_registration_context_t);
+#endif // APP_FEATURE_POOL_REGISTRATION
+REPORT_TYPE(output_context_t);
+#ifdef APP_FEATURE_TOKEN_MINTING
+REPORT_TYPE(mint_context_t);
+#endif // APP_FEATURE_TOKEN_MINTING
+
+REPORT_TYPE(displayState_t);
+REPORT_TYPE(paginatedTextState_t);
+REPORT_TYPE(promptState_t);
+
+#endif // RAM_REPORT
@@ -9,6 +9,8 @@
 #include "hash.h"
 #include "bip44.h"
 #include "keyDerivation.h"
+#include "keyHashCache.h"
+#include "signTxSession.h"
 #include "addressUtilsByron.h"
 #include "addressUtilsShelley.h"
 #include "crc32.h"
@@ -19,6 +21,7 @@
 #include "uiHelpers.h"
 #include "tokens.h"
 #include "deriveNativeScriptHash.h"
+#include "state.h"
 
 
 void handleRunTests(
@@ -48,6 +51,12 @@ void handleRunTests(
 		run_cbor_test();
 		run_bip44_test();
 		run_key_derivation_test();
+		#if defined(APP_FEATURE_KEY_HASH_CACHE)
+		run_keyHashCache_test();
+		#endif
+		#if defined(APP_FEATURE_SIGN_TX_SESSION)
+		run_signTxSession_test();
+		#endif
 		#if !defined(APP_XS)
 		run_addressUtilsByron_test();
 		#endif
@@ -56,6 +65,7 @@ void handleRunTests(
 		#if defined(APP_FEATURE_NATIVE_SCRIPT_HASH)
 		run_nativeScriptHashBuilder_test();
 		#endif
+		run_state_test();
 		PRINTF("All tests done\n");
 
 	} END_ASSERT_NOEXCEPT;
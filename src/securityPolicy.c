@@ -73,6 +73,27 @@ static address_type_t getDestinationAddressType(const tx_output_destination_t* d
 #define SHOW_UNLESS(expr)    if (!(expr)) return POLICY_SHOW_BEFORE_RESPONSE;
 
 
+// the most restrictive policy wins, so that the whole batch
+// gets the UI treatment required by any of its items;
+// denied items must be rejected before combining
+security_policy_t combineBatchPolicies(security_policy_t acc, security_policy_t policy)
+{
+	ASSERT(acc != POLICY_DENY);
+	ASSERT(policy != POLICY_DENY);
+
+	if (acc == POLICY_PROMPT_WARN_UNUSUAL || policy == POLICY_PROMPT_WARN_UNUSUAL) {
+		return POLICY_PROMPT_WARN_UNUSUAL;
+	}
+	if (acc == POLICY_PROMPT_BEFORE_RESPONSE || policy == POLICY_PROMPT_BEFORE_RESPONSE) {
+		return POLICY_PROMPT_BEFORE_RESPONSE;
+	}
+	if (acc == POLICY_SHOW_BEFORE_RESPONSE || policy == POLICY_SHOW_BEFORE_RESPONSE) {
+		return POLICY_SHOW_BEFORE_RESPONSE;
+	}
+	ASSERT(policy == POLICY_ALLOW_WITHOUT_PROMPT);
+	return POLICY_ALLOW_WITHOUT_PROMPT;
+}
+
 security_policy_t policyForDerivePrivateKey(const bip44_path_t* path)
 {
 	switch (bip44_classifyPath(path)) {
@@ -1862,7 +1883,7 @@ static bool required_signers_allowed(const sign_tx_signingmode_t txSigningMode)
 	}
 }
 
-static bool is_required_signer_allowed(bip44_path_t* path)
+static bool is_required_signer_allowed(const bip44_path_t* path)
 {
 	switch (bip44_classifyPath(path)) {
 	case PATH_ORDINARY_ACCOUNT:
@@ -1891,7 +1912,7 @@ static bool is_required_signer_allowed(bip44_path_t* path)
 
 security_policy_t policyForSignTxRequiredSigner(
         const sign_tx_signingmode_t txSigningMode,
-        sign_tx_required_signer_t* requiredSigner
+        const sign_tx_required_signer_t* requiredSigner
 )
 {
 	DENY_UNLESS(required_signers_allowed(txSigningMode));
@@ -9,6 +9,8 @@
 #include "signTxAuxData.h"
 #include "signTx.h"
 
+security_policy_t combineBatchPolicies(security_policy_t acc, security_policy_t policy);
+
 security_policy_t policyForDerivePrivateKey(const bip44_path_t* path);
 
 security_policy_t policyForGetPublicKeysInit(uint32_t numPaths);
@@ -193,7 +195,7 @@ security_policy_t policyForSignTxCollateralInput(
 
 security_policy_t policyForSignTxRequiredSigner(
         const sign_tx_signingmode_t txSigningMode,
-        sign_tx_required_signer_t* requiredSigner
+        const sign_tx_required_signer_t* requiredSigner
 );
 
 security_policy_t policyForSignTxWitness(
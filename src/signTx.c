@@ -15,6 +15,7 @@
 #include "bufView.h"
 #include "securityPolicy.h"
 #include "signTx_ui.h"
+#include "signTxSession.h"
 
 static ins_sign_tx_context_t* ctx = &(instructionState.signTxContext);
 
@@ -55,6 +56,10 @@ static inline void initTxAuxDataCtx()
 
 static inline void initTxWitnessCtx()
 {
+	STATIC_ASSERT(
+	        SIZEOF(ins_sign_tx_witness_context_t) <= SIZEOF(ins_sign_tx_body_context_t),
+	        "the witness cache must not grow the tx part union"
+	);
 	explicit_bzero(&ctx->txPartCtx, SIZEOF(ctx->txPartCtx));
 	{
 		WITNESS_CTX->currentWitness = 0;
@@ -778,42 +783,55 @@ static void signTx_handleAuxDataAPDU(uint8_t p2, const uint8_t* wireDataBuffer,
 
 // ============================== INPUTS ==============================
 
-// Advance stage to the next input
+// Advance stage past the inputs received in the current APDU
 static void ui_advanceState_input()
 {
-	ASSERT(BODY_CTX->currentInput < ctx->numInputs);
-	BODY_CTX->currentInput++;
+	const uint8_t numInputs = BODY_CTX->stageData.inputs.numInputs;
+	ASSERT(BODY_CTX->currentInput + numInputs <= ctx->numInputs);
+	BODY_CTX->currentInput += numInputs;
 
 	if (BODY_CTX->currentInput == ctx->numInputs) {
 		tx_advanceStage();
 	}
 }
 
-static void parseInput(const uint8_t* wireDataBuffer, size_t wireDataSize)
+// Inputs, collateral inputs and reference inputs share the wire format.
+// With SIGN_TX_P2_BATCH, the data start with the number of packed inputs.
+static void parseInputs(
+        uint8_t p2,
+        const uint8_t* wireDataBuffer, size_t wireDataSize,
+        uint16_t numRemainingInputs
+)
 {
-	sign_tx_transaction_input_t* input = &BODY_CTX->stageData.input;
+	sign_tx_transaction_inputs_t* inputs = &BODY_CTX->stageData.inputs;
 
-	struct {
-		uint8_t txHash[TX_HASH_LENGTH];
-		uint8_t index[4];
-	}* wireUtxo = (void*) wireDataBuffer;
+	read_view_t view = make_read_view(wireDataBuffer, wireDataBuffer + wireDataSize);
 
-	VALIDATE(wireDataSize == SIZEOF(*wireUtxo), ERR_INVALID_DATA);
+	switch (p2) {
+	case SIGN_TX_P2_SINGLE:
+		inputs->numInputs = 1;
+		break;
 
-	tx_input_t* inputData = &input->input_data;
-	memmove(inputData->txHashBuffer, wireUtxo->txHash, SIZEOF(inputData->txHashBuffer));
-	inputData->index = u4be_read(wireUtxo->index);
-}
+	case SIGN_TX_P2_BATCH:
+		inputs->numInputs = parse_u1be(&view);
+		VALIDATE(inputs->numInputs > 0, ERR_INVALID_DATA);
+		VALIDATE(inputs->numInputs <= SIGN_TX_INPUT_BATCH_MAX, ERR_INVALID_DATA);
+		break;
 
-static void constructInputLabel(const char* prefix, uint16_t index)
-{
-	char* label = BODY_CTX->stageData.input.label;
-	const size_t labelSize = SIZEOF(BODY_CTX->stageData.input.label);
-	explicit_bzero(label, labelSize);
-	// indexed from 0 as agreed with IOG on Slack
-	snprintf(label, labelSize, "%s #%u", prefix, index);
-	// make sure all the information is displayed to the user
-	ASSERT(strlen(label) + 1 < labelSize);
+	default:
+		THROW(ERR_INVALID_REQUEST_PARAMETERS);
+	}
+
+	// the batch must not exceed the number of inputs announced in init
+	VALIDATE(inputs->numInputs <= numRemainingInputs, ERR_INVALID_DATA);
+
+	for (size_t i = 0; i < inputs->numInputs; i++) {
+		tx_input_t* inputData = &inputs->inputs[i];
+		view_parseBuffer(inputData->txHashBuffer, &view, SIZEOF(inputData->txHashBuffer));
+		inputData->index = parse_u4be(&view);
+	}
+
+	VALIDATE(view_remainingSize(&view) == 0, ERR_INVALID_DATA);
 }
 
 static void ui_selectInputStep(security_policy_t policy)
@@ -837,28 +855,26 @@ static void signTx_handleInputAPDU(uint8_t p2, const uint8_t* wireDataBuffer, si
 		// sanity checks
 		CHECK_STAGE(SIGN_STAGE_BODY_INPUTS);
 		ASSERT(BODY_CTX->currentInput < ctx->numInputs);
-
-		VALIDATE(p2 == P2_UNUSED, ERR_INVALID_REQUEST_PARAMETERS);
 	}
 
-	parseInput(wireDataBuffer, wireDataSize);
+	parseInputs(p2, wireDataBuffer, wireDataSize, ctx->numInputs - BODY_CTX->currentInput);
 
-	security_policy_t policy = policyForSignTxInput(ctx->commonTxData.txSigningMode);
-	TRACE("Policy: %d", (int) policy);
-	ENSURE_NOT_DENIED(policy);
+	security_policy_t policy = POLICY_ALLOW_WITHOUT_PROMPT;
+	for (size_t i = 0; i < BODY_CTX->stageData.inputs.numInputs; i++) {
+		security_policy_t inputPolicy = policyForSignTxInput(ctx->commonTxData.txSigningMode);
+		TRACE("Policy: %d", (int) inputPolicy);
+		ENSURE_NOT_DENIED(inputPolicy);
+
+		policy = combineBatchPolicies(policy, inputPolicy);
 
-	{
 		// add to tx
 		TRACE("Adding input to tx hash");
 		txHashBuilder_addInput(
 		        &BODY_CTX->txHashBuilder,
-		        &BODY_CTX->stageData.input.input_data
+		        &BODY_CTX->stageData.inputs.inputs[i]
 		);
 	}
 	{
-		// not needed if input is not shown, but does not cost much time, so not worth branching
-		constructInputLabel("Input", BODY_CTX->currentInput);
-
 		ctx->ui_advanceState = ui_advanceState_input;
 		ui_selectInputStep(policy);
 		signTx_handleInput_ui_runStep();
@@ -1164,7 +1180,7 @@ static void _setCredential(
 
 	case EXT_CREDENTIAL_KEY_PATH:
 		credential->type = CREDENTIAL_KEY_HASH;
-		bip44_pathToKeyHash(
+		tx_pathToKeyHash(
 		        &extCredential->keyPath,
 		        credential->keyHash, SIZEOF(credential->keyHash)
 		);
@@ -1197,7 +1213,7 @@ static void _setDRep(
 
 	case EXT_DREP_KEY_PATH:
 		drep->type = DREP_KEY_HASH;
-		bip44_pathToKeyHash(
+		tx_pathToKeyHash(
 		        &extDRep->keyPath,
 		        drep->keyHash, SIZEOF(drep->keyHash)
 		);
@@ -1347,7 +1363,7 @@ static void _addCertificateDataToTx(
 		uint8_t hash[ADDRESS_KEY_HASH_LENGTH] = {0};
 		ext_credential_t* extCredential = &BODY_CTX->stageData.certificate.poolCredential;
 		ASSERT(extCredential->type == EXT_CREDENTIAL_KEY_PATH);
-		bip44_pathToKeyHash(
+		tx_pathToKeyHash(
 		        &extCredential->keyPath,
 		        hash, SIZEOF(hash)
 		);
@@ -1633,25 +1649,30 @@ static void signTx_handleCertificateAPDU(uint8_t p2, const uint8_t* wireDataBuff
 // ============================== WITHDRAWALS ==============================
 
 __noinline_due_to_stack__
-static void _addWithdrawalToTxHash(bool validateCanonicalOrdering)
+static void _addWithdrawalToTxHash(const sign_tx_withdrawal_data_t* withdrawal, bool validateCanonicalOrdering)
 {
 	uint8_t rewardAddress[REWARD_ACCOUNT_SIZE] = {0};
 
-	switch (BODY_CTX->stageData.withdrawal.stakeCredential.type) {
-	case EXT_CREDENTIAL_KEY_PATH:
-		constructRewardAddressFromKeyPath(
-		        &BODY_CTX->stageData.withdrawal.stakeCredential.keyPath,
+	switch (withdrawal->stakeCredential.type) {
+	case EXT_CREDENTIAL_KEY_PATH: {
+		ASSERT(bip44_isOrdinaryStakingKeyPath(&withdrawal->stakeCredential.keyPath));
+		uint8_t keyHash[ADDRESS_KEY_HASH_LENGTH] = {0};
+		tx_pathToKeyHash(&withdrawal->stakeCredential.keyPath, keyHash, SIZEOF(keyHash));
+		constructRewardAddressFromHash(
 		        ctx->commonTxData.networkId,
+		        REWARD_HASH_SOURCE_KEY,
+		        keyHash, SIZEOF(keyHash),
 		        rewardAddress,
 		        SIZEOF(rewardAddress)
 		);
 		break;
+	}
 	case EXT_CREDENTIAL_KEY_HASH:
 		constructRewardAddressFromHash(
 		        ctx->commonTxData.networkId,
 		        REWARD_HASH_SOURCE_KEY,
-		        BODY_CTX->stageData.withdrawal.stakeCredential.keyHash,
-		        SIZEOF(BODY_CTX->stageData.withdrawal.stakeCredential.keyHash),
+		        withdrawal->stakeCredential.keyHash,
+		        SIZEOF(withdrawal->stakeCredential.keyHash),
 		        rewardAddress,
 		        SIZEOF(rewardAddress)
 		);
@@ -1660,8 +1681,8 @@ static void _addWithdrawalToTxHash(bool validateCanonicalOrdering)
 		constructRewardAddressFromHash(
 		        ctx->commonTxData.networkId,
 		        REWARD_HASH_SOURCE_SCRIPT,
-		        BODY_CTX->stageData.withdrawal.stakeCredential.scriptHash,
-		        SIZEOF(BODY_CTX->stageData.withdrawal.stakeCredential.scriptHash),
+		        withdrawal->stakeCredential.scriptHash,
+		        SIZEOF(withdrawal->stakeCredential.scriptHash),
 		        rewardAddress,
 		        SIZEOF(rewardAddress)
 		);
@@ -1672,29 +1693,68 @@ static void _addWithdrawalToTxHash(bool validateCanonicalOrdering)
 	}
 
 	{
-		STATIC_ASSERT(SIZEOF(BODY_CTX->stageData.withdrawal.previousRewardAccount) == REWARD_ACCOUNT_SIZE, "wrong reward account buffer size");
+		uint8_t* previousRewardAccount = BODY_CTX->stageData.withdrawals.previousRewardAccount;
+		STATIC_ASSERT(SIZEOF(BODY_CTX->stageData.withdrawals.previousRewardAccount) == REWARD_ACCOUNT_SIZE, "wrong reward account buffer size");
 		STATIC_ASSERT(SIZEOF(rewardAddress) == REWARD_ACCOUNT_SIZE, "wrong reward account buffer size");
 
 		if (validateCanonicalOrdering) {
 			// compare with previous map entry
 			VALIDATE(cbor_mapKeyFulfillsCanonicalOrdering(
-			                 BODY_CTX->stageData.withdrawal.previousRewardAccount, REWARD_ACCOUNT_SIZE,
+			                 previousRewardAccount, REWARD_ACCOUNT_SIZE,
 			                 rewardAddress, REWARD_ACCOUNT_SIZE
 			         ), ERR_INVALID_DATA);
 		}
 
 		// update the value for potential future comparison
-		memmove(BODY_CTX->stageData.withdrawal.previousRewardAccount, rewardAddress, REWARD_ACCOUNT_SIZE);
+		memmove(previousRewardAccount, rewardAddress, REWARD_ACCOUNT_SIZE);
 	}
 
 	TRACE("Adding withdrawal to tx hash");
 	txHashBuilder_addWithdrawal(
 	        &BODY_CTX->txHashBuilder,
 	        rewardAddress, SIZEOF(rewardAddress),
-	        BODY_CTX->stageData.withdrawal.amount
+	        withdrawal->amount
 	);
 }
 
+// With SIGN_TX_P2_BATCH, the data start with the number of packed withdrawals.
+static void _parseWithdrawals(uint8_t p2, const uint8_t* wireDataBuffer, size_t wireDataSize)
+{
+	sign_tx_withdrawals_t* withdrawals = &BODY_CTX->stageData.withdrawals;
+
+	TRACE_BUFFER(wireDataBuffer, wireDataSize);
+	read_view_t view = make_read_view(wireDataBuffer, wireDataBuffer + wireDataSize);
+
+	switch (p2) {
+	case SIGN_TX_P2_SINGLE:
+		withdrawals->numWithdrawals = 1;
+		break;
+
+	case SIGN_TX_P2_BATCH:
+		withdrawals->numWithdrawals = parse_u1be(&view);
+		VALIDATE(withdrawals->numWithdrawals > 0, ERR_INVALID_DATA);
+		VALIDATE(withdrawals->numWithdrawals <= SIGN_TX_WITHDRAWAL_BATCH_MAX, ERR_INVALID_DATA);
+		break;
+
+	default:
+		THROW(ERR_INVALID_REQUEST_PARAMETERS);
+	}
+
+	// the batch must not exceed the number of withdrawals announced in init
+	VALIDATE(
+	        withdrawals->numWithdrawals <= ctx->numWithdrawals - BODY_CTX->currentWithdrawal,
+	        ERR_INVALID_DATA
+	);
+
+	for (size_t i = 0; i < withdrawals->numWithdrawals; i++) {
+		sign_tx_withdrawal_data_t* withdrawal = &withdrawals->withdrawals[i];
+		withdrawal->amount = parse_u8be(&view);
+		_parseCredential(&view, &withdrawal->stakeCredential);
+	}
+
+	VALIDATE(view_remainingSize(&view) == 0, ERR_INVALID_DATA);
+}
+
 __noinline_due_to_stack__
 static void signTx_handleWithdrawalAPDU(uint8_t p2, const uint8_t* wireDataBuffer, size_t wireDataSize)
 {
@@ -1703,37 +1763,35 @@ static void signTx_handleWithdrawalAPDU(uint8_t p2, const uint8_t* wireDataBuffe
 		// sanity checks
 		CHECK_STAGE(SIGN_STAGE_BODY_WITHDRAWALS);
 		ASSERT(BODY_CTX->currentWithdrawal < ctx->numWithdrawals);
-
-		VALIDATE(p2 == P2_UNUSED, ERR_INVALID_REQUEST_PARAMETERS);
 	}
 
-	// we can't bzero the whole stageData.withdrawal since
-	// we need to compare it with the previous one (canonical ordering check)
-	BODY_CTX->stageData.withdrawal.amount = 0;
-	explicit_bzero(&BODY_CTX->stageData.withdrawal.stakeCredential, SIZEOF(BODY_CTX->stageData.withdrawal.stakeCredential));
-
+	// we can't bzero the whole stageData.withdrawals since we need
+	// to compare with the previous reward account (canonical ordering check)
 	{
-		// parse input
-		TRACE_BUFFER(wireDataBuffer, wireDataSize);
+		sign_tx_withdrawals_t* withdrawals = &BODY_CTX->stageData.withdrawals;
+		explicit_bzero(withdrawals->withdrawals, SIZEOF(withdrawals->withdrawals));
+		withdrawals->numWithdrawals = 0;
+		withdrawals->currentDisplayedWithdrawal = 0;
+	}
 
-		read_view_t view = make_read_view(wireDataBuffer, wireDataBuffer + wireDataSize);
-		BODY_CTX->stageData.withdrawal.amount = parse_u8be(&view);
+	_parseWithdrawals(p2, wireDataBuffer, wireDataSize);
 
-		_parseCredential(&view, &BODY_CTX->stageData.withdrawal.stakeCredential);
+	security_policy_t policy = POLICY_ALLOW_WITHOUT_PROMPT;
+	for (size_t i = 0; i < BODY_CTX->stageData.withdrawals.numWithdrawals; i++) {
+		const sign_tx_withdrawal_data_t* withdrawal = &BODY_CTX->stageData.withdrawals.withdrawals[i];
 
-		VALIDATE(view_remainingSize(&view) == 0, ERR_INVALID_DATA);
+		security_policy_t withdrawalPolicy = policyForSignTxWithdrawal(
+		                                             ctx->commonTxData.txSigningMode,
+		                                             &withdrawal->stakeCredential
+		                                     );
+		TRACE("Policy: %d", (int) withdrawalPolicy);
+		ENSURE_NOT_DENIED(withdrawalPolicy);
 
-	}
+		policy = combineBatchPolicies(policy, withdrawalPolicy);
 
-	security_policy_t policy = policyForSignTxWithdrawal(
-	                                   ctx->commonTxData.txSigningMode,
-	                                   &BODY_CTX->stageData.withdrawal.stakeCredential
-	                           );
-	TRACE("Policy: %d", (int) policy);
-	ENSURE_NOT_DENIED(policy);
-
-	const bool validateCanonicalOrdering = BODY_CTX->currentWithdrawal > 0;
-	_addWithdrawalToTxHash(validateCanonicalOrdering);
+		const bool validateCanonicalOrdering = BODY_CTX->currentWithdrawal + i > 0;
+		_addWithdrawalToTxHash(withdrawal, validateCanonicalOrdering);
+	}
 
 	{
 		// select UI steps
@@ -1876,8 +1934,9 @@ static void signTx_handleScriptDataHashAPDU(uint8_t p2, const uint8_t* wireDataB
 // Advance stage to the next collateral input
 static void ui_advanceState_collateralInput()
 {
-	ASSERT(BODY_CTX->currentCollateral < ctx->numCollateralInputs);
-	BODY_CTX->currentCollateral++;
+	const uint8_t numInputs = BODY_CTX->stageData.inputs.numInputs;
+	ASSERT(BODY_CTX->currentCollateral + numInputs <= ctx->numCollateralInputs);
+	BODY_CTX->currentCollateral += numInputs;
 
 	if (BODY_CTX->currentCollateral == ctx->numCollateralInputs) {
 		tx_advanceStage();
@@ -1892,31 +1951,32 @@ static void signTx_handleCollateralInputAPDU(uint8_t p2, const uint8_t* wireData
 		// sanity checks
 		CHECK_STAGE(SIGN_STAGE_BODY_COLLATERAL_INPUTS);
 		ASSERT(BODY_CTX->currentCollateral < ctx->numCollateralInputs);
-
-		VALIDATE(p2 == P2_UNUSED, ERR_INVALID_REQUEST_PARAMETERS);
 	}
 
-	parseInput(wireDataBuffer, wireDataSize);
+	parseInputs(
+	        p2, wireDataBuffer, wireDataSize,
+	        ctx->numCollateralInputs - BODY_CTX->currentCollateral
+	);
 
-	security_policy_t policy = policyForSignTxCollateralInput(
-	                                   ctx->commonTxData.txSigningMode,
-	                                   ctx->includeTotalCollateral
-	                           );
-	TRACE("Policy: %d", (int) policy);
-	ENSURE_NOT_DENIED(policy);
+	security_policy_t policy = POLICY_ALLOW_WITHOUT_PROMPT;
+	for (size_t i = 0; i < BODY_CTX->stageData.inputs.numInputs; i++) {
+		security_policy_t inputPolicy = policyForSignTxCollateralInput(
+		                                        ctx->commonTxData.txSigningMode,
+		                                        ctx->includeTotalCollateral
+		                                );
+		TRACE("Policy: %d", (int) inputPolicy);
+		ENSURE_NOT_DENIED(inputPolicy);
+
+		policy = combineBatchPolicies(policy, inputPolicy);
 
-	{
 		// add to tx
 		TRACE("Adding collateral input to tx hash");
 		txHashBuilder_addCollateralInput(
 		        &BODY_CTX->txHashBuilder,
-		        &BODY_CTX->stageData.input.input_data
+		        &BODY_CTX->stageData.inputs.inputs[i]
 		);
 	}
 	{
-		// not needed if input is not shown, but does not cost much time, so not worth branching
-		constructInputLabel("Collat. input", BODY_CTX->currentCollateral);
-
 		ctx->ui_advanceState = ui_advanceState_collateralInput;
 		ui_selectInputStep(policy);
 		signTx_handleInput_ui_runStep();
@@ -1925,58 +1985,98 @@ static void signTx_handleCollateralInputAPDU(uint8_t p2, const uint8_t* wireData
 
 // ========================= REQUIRED SIGNERS ===========================
 
-__noinline_due_to_stack__
-static void signTx_handleRequiredSignerAPDU(uint8_t p2, const uint8_t* wireDataBuffer, size_t wireDataSize)
+// With SIGN_TX_P2_BATCH, the data start with the number of packed required signers.
+static void _parseRequiredSigners(uint8_t p2, const uint8_t* wireDataBuffer, size_t wireDataSize)
 {
-	TRACE_STACK_USAGE();
-	{
-		// sanity checks
-		CHECK_STAGE(SIGN_STAGE_BODY_REQUIRED_SIGNERS);
-		ASSERT(BODY_CTX->currentRequiredSigner < ctx->numRequiredSigners);
+	sign_tx_required_signers_t* requiredSigners = &BODY_CTX->stageData.requiredSigners;
 
-		VALIDATE(p2 == P2_UNUSED, ERR_INVALID_REQUEST_PARAMETERS);
+	TRACE_BUFFER(wireDataBuffer, wireDataSize);
+	read_view_t view = make_read_view(wireDataBuffer, wireDataBuffer + wireDataSize);
+
+	switch (p2) {
+	case SIGN_TX_P2_SINGLE:
+		requiredSigners->numRequiredSigners = 1;
+		break;
+
+	case SIGN_TX_P2_BATCH:
+		requiredSigners->numRequiredSigners = parse_u1be(&view);
+		VALIDATE(requiredSigners->numRequiredSigners > 0, ERR_INVALID_DATA);
+		VALIDATE(requiredSigners->numRequiredSigners <= SIGN_TX_REQUIRED_SIGNER_BATCH_MAX, ERR_INVALID_DATA);
+		break;
+
+	default:
+		THROW(ERR_INVALID_REQUEST_PARAMETERS);
 	}
 
-	{
-		TRACE_BUFFER(wireDataBuffer, wireDataSize);
+	// the batch must not exceed the number of required signers announced in init
+	VALIDATE(
+	        requiredSigners->numRequiredSigners <= ctx->numRequiredSigners - BODY_CTX->currentRequiredSigner,
+	        ERR_INVALID_DATA
+	);
 
-		read_view_t view = make_read_view(wireDataBuffer, wireDataBuffer + wireDataSize);
-		BODY_CTX->stageData.requiredSigner.type = parse_u1be(&view);
-		STATIC_ASSERT(SIZEOF(BODY_CTX->stageData.requiredSigner.keyHash) == ADDRESS_KEY_HASH_LENGTH, "wrong key hash length");
-		switch (BODY_CTX->stageData.requiredSigner.type) {
+	for (size_t i = 0; i < requiredSigners->numRequiredSigners; i++) {
+		sign_tx_required_signer_t* requiredSigner = &requiredSigners->requiredSigners[i];
+
+		requiredSigner->type = parse_u1be(&view);
+		STATIC_ASSERT(SIZEOF(requiredSigner->keyHash) == ADDRESS_KEY_HASH_LENGTH, "wrong key hash length");
+		switch (requiredSigner->type) {
 		case REQUIRED_SIGNER_WITH_PATH:
-			_parsePathSpec(&view, &BODY_CTX->stageData.requiredSigner.keyPath);
+			_parsePathSpec(&view, &requiredSigner->keyPath);
 			break;
 		case REQUIRED_SIGNER_WITH_HASH:
-			view_parseBuffer(BODY_CTX->stageData.requiredSigner.keyHash, &view, ADDRESS_KEY_HASH_LENGTH);
+			view_parseBuffer(requiredSigner->keyHash, &view, ADDRESS_KEY_HASH_LENGTH);
 			break;
 		}
-		VALIDATE(view_remainingSize(&view) == 0, ERR_INVALID_DATA);
 	}
 
-	security_policy_t policy = policyForSignTxRequiredSigner(
-	                                   ctx->commonTxData.txSigningMode,
-	                                   &BODY_CTX->stageData.requiredSigner
-	                           );
-	TRACE("Policy: %d", (int) policy);
-	ENSURE_NOT_DENIED(policy);
+	VALIDATE(view_remainingSize(&view) == 0, ERR_INVALID_DATA);
+}
+
+__noinline_due_to_stack__
+static void _addRequiredSignerToTxHash(const sign_tx_required_signer_t* requiredSigner)
+{
+	TRACE("Adding required signer to tx hash");
+	if (requiredSigner->type == REQUIRED_SIGNER_WITH_PATH) {
+		uint8_t keyHash[ADDRESS_KEY_HASH_LENGTH] = {0};
+		tx_pathToKeyHash(&requiredSigner->keyPath, keyHash, SIZEOF(keyHash));
+		txHashBuilder_addRequiredSigner(
+		        &BODY_CTX->txHashBuilder,
+		        keyHash, SIZEOF(keyHash)
+		);
+	} else {
+		txHashBuilder_addRequiredSigner(
+		        &BODY_CTX->txHashBuilder,
+		        requiredSigner->keyHash, SIZEOF(requiredSigner->keyHash)
+		);
+	}
+}
 
+__noinline_due_to_stack__
+static void signTx_handleRequiredSignerAPDU(uint8_t p2, const uint8_t* wireDataBuffer, size_t wireDataSize)
+{
+	TRACE_STACK_USAGE();
 	{
-		// add to tx
-		TRACE("Adding required signer to tx hash");
-		if (BODY_CTX->stageData.requiredSigner.type == REQUIRED_SIGNER_WITH_PATH) {
-			uint8_t keyHash[ADDRESS_KEY_HASH_LENGTH] = {0};
-			bip44_pathToKeyHash(&BODY_CTX->stageData.requiredSigner.keyPath, keyHash, SIZEOF(keyHash));
-			txHashBuilder_addRequiredSigner(
-			        &BODY_CTX->txHashBuilder,
-			        keyHash, SIZEOF(keyHash)
-			);
-		} else {
-			txHashBuilder_addRequiredSigner(
-			        &BODY_CTX->txHashBuilder,
-			        BODY_CTX->stageData.requiredSigner.keyHash, SIZEOF(BODY_CTX->stageData.requiredSigner.keyHash)
-			);
-		}
+		// sanity checks
+		CHECK_STAGE(SIGN_STAGE_BODY_REQUIRED_SIGNERS);
+		ASSERT(BODY_CTX->currentRequiredSigner < ctx->numRequiredSigners);
+	}
+
+	_parseRequiredSigners(p2, wireDataBuffer, wireDataSize);
+
+	security_policy_t policy = POLICY_ALLOW_WITHOUT_PROMPT;
+	for (size_t i = 0; i < BODY_CTX->stageData.requiredSigners.numRequiredSigners; i++) {
+		const sign_tx_required_signer_t* requiredSigner = &BODY_CTX->stageData.requiredSigners.requiredSigners[i];
+
+		security_policy_t signerPolicy = policyForSignTxRequiredSigner(
+		                                         ctx->commonTxData.txSigningMode,
+		                                         requiredSigner
+		                                 );
+		TRACE("Policy: %d", (int) signerPolicy);
+		ENSURE_NOT_DENIED(signerPolicy);
+
+		policy = combineBatchPolicies(policy, signerPolicy);
+
+		_addRequiredSignerToTxHash(requiredSigner);
 	}
 
 	{
@@ -2069,8 +2169,9 @@ static void signTx_handleTotalCollateralAPDU(uint8_t p2, const uint8_t* wireData
 // Advance stage to the next input
 static void ui_advanceState_ReferenceInput()
 {
-	ASSERT(BODY_CTX->currentReferenceInput < ctx->numReferenceInputs);
-	BODY_CTX->currentReferenceInput++;
+	const uint8_t numInputs = BODY_CTX->stageData.inputs.numInputs;
+	ASSERT(BODY_CTX->currentReferenceInput + numInputs <= ctx->numReferenceInputs);
+	BODY_CTX->currentReferenceInput += numInputs;
 
 	if (BODY_CTX->currentReferenceInput == ctx->numReferenceInputs) {
 		tx_advanceStage();
@@ -2085,28 +2186,29 @@ static void signTx_handleReferenceInputAPDU(uint8_t p2, const uint8_t* wireDataB
 		// sanity checks
 		CHECK_STAGE(SIGN_STAGE_BODY_REFERENCE_INPUTS);
 		ASSERT(BODY_CTX->currentReferenceInput < ctx->numReferenceInputs);
-
-		VALIDATE(p2 == P2_UNUSED, ERR_INVALID_REQUEST_PARAMETERS);
 	}
 	// Parsed in same way as the inputs
-	parseInput(wireDataBuffer, wireDataSize);
+	parseInputs(
+	        p2, wireDataBuffer, wireDataSize,
+	        ctx->numReferenceInputs - BODY_CTX->currentReferenceInput
+	);
 
-	security_policy_t policy = policyForSignTxReferenceInput(ctx->commonTxData.txSigningMode);
-	TRACE("Policy: %d", (int) policy);
-	ENSURE_NOT_DENIED(policy);
+	security_policy_t policy = POLICY_ALLOW_WITHOUT_PROMPT;
+	for (size_t i = 0; i < BODY_CTX->stageData.inputs.numInputs; i++) {
+		security_policy_t inputPolicy = policyForSignTxReferenceInput(ctx->commonTxData.txSigningMode);
+		TRACE("Policy: %d", (int) inputPolicy);
+		ENSURE_NOT_DENIED(inputPolicy);
+
+		policy = combineBatchPolicies(policy, inputPolicy);
 
-	{
 		// add to tx
 		TRACE("Adding reference input to tx hash");
 		txHashBuilder_addReferenceInput(
 		        &BODY_CTX->txHashBuilder,
-		        &BODY_CTX->stageData.input.input_data
+		        &BODY_CTX->stageData.inputs.inputs[i]
 		);
 	}
 	{
-		// not needed if input is not shown, but does not cost much time, so not worth branching
-		constructInputLabel("Refer. input", BODY_CTX->currentReferenceInput);
-
 		ctx->ui_advanceState = ui_advanceState_ReferenceInput;
 		ui_selectInputStep(policy);
 		signTx_handleInput_ui_runStep();
@@ -2125,7 +2227,7 @@ static void _setVoter(
 
 	case EXT_VOTER_COMMITTEE_HOT_KEY_PATH:
 		voter->type = VOTER_COMMITTEE_HOT_KEY_HASH;
-		bip44_pathToKeyHash(
+		tx_pathToKeyHash(
 		        &extVoter->keyPath,
 		        voter->keyHash, SIZEOF(voter->keyHash)
 		);
@@ -2133,7 +2235,7 @@ static void _setVoter(
 
 	case EXT_VOTER_DREP_KEY_PATH:
 		voter->type = VOTER_DREP_KEY_HASH;
-		bip44_pathToKeyHash(
+		tx_pathToKeyHash(
 		        &extVoter->keyPath,
 		        voter->keyHash, SIZEOF(voter->keyHash)
 		);
@@ -2141,7 +2243,7 @@ static void _setVoter(
 
 	case EXT_VOTER_STAKE_POOL_KEY_PATH:
 		voter->type = VOTER_STAKE_POOL_KEY_HASH;
-		bip44_pathToKeyHash(
+		tx_pathToKeyHash(
 		        &extVoter->keyPath,
 		        voter->keyHash, SIZEOF(voter->keyHash)
 		);
@@ -2411,7 +2513,12 @@ static void signTx_handleConfirmAPDU(uint8_t p2, const uint8_t* wireDataBuffer M
 		//sanity checks
 		CHECK_STAGE(SIGN_STAGE_CONFIRM);
 
+		#ifdef APP_FEATURE_SIGN_TX_SESSION
+		ctx->openSession = (p2 == SIGN_TX_CONFIRM_P2_OPEN_SESSION);
+		VALIDATE(p2 == P2_UNUSED || ctx->openSession, ERR_INVALID_REQUEST_PARAMETERS);
+		#else
 		VALIDATE(p2 == P2_UNUSED, ERR_INVALID_REQUEST_PARAMETERS);
+		#endif // APP_FEATURE_SIGN_TX_SESSION
 	}
 
 	{
@@ -2452,6 +2559,71 @@ static void signTx_handleConfirmAPDU(uint8_t p2, const uint8_t* wireDataBuffer M
 
 // ============================== WITNESS ==============================
 
+static void _parseWitnessPaths(uint8_t p2, const uint8_t* wireDataBuffer, size_t wireDataSize)
+{
+	TRACE_BUFFER(wireDataBuffer, wireDataSize);
+
+	read_view_t view = make_read_view(wireDataBuffer, wireDataBuffer + wireDataSize);
+
+	switch (p2) {
+	case SIGN_TX_P2_SINGLE:
+		WITNESS_CTX->stageData.numWitnesses = 1;
+		break;
+
+	case SIGN_TX_P2_BATCH:
+		WITNESS_CTX->stageData.numWitnesses = parse_u1be(&view);
+		VALIDATE(WITNESS_CTX->stageData.numWitnesses > 0, ERR_INVALID_DATA);
+		VALIDATE(WITNESS_CTX->stageData.numWitnesses <= SIGN_TX_WITNESS_BATCH_MAX, ERR_INVALID_DATA);
+		break;
+
+	default:
+		THROW(ERR_INVALID_REQUEST_PARAMETERS);
+	}
+
+	// the batch must not exceed the number of witnesses announced in init
+	VALIDATE(
+	        WITNESS_CTX->currentWitness + WITNESS_CTX->stageData.numWitnesses <= ctx->numWitnesses,
+	        ERR_INVALID_DATA
+	);
+
+	for (size_t i = 0; i < WITNESS_CTX->stageData.numWitnesses; i++) {
+		_parsePathSpec(&view, &WITNESS_CTX->stageData.paths[i]);
+	}
+
+	VALIDATE(view_remainingSize(&view) == 0, ERR_INVALID_DATA);
+}
+
+// the tx hash does not change during the witness stage,
+// so a path always gets the same signature
+static bool _getCachedWitness(const bip44_path_t* path, uint8_t* signature, size_t signatureSize)
+{
+	ASSERT(signatureSize == ED25519_SIGNATURE_LENGTH);
+
+	for (size_t i = 0; i < WITNESS_CTX->cache.numEntries; i++) {
+		const sign_tx_witness_cache_entry_t* entry = &WITNESS_CTX->cache.entries[i];
+		if (bip44_pathsEqual(&entry->path, path)) {
+			memmove(signature, entry->signature, ED25519_SIGNATURE_LENGTH);
+			return true;
+		}
+	}
+	return false;
+}
+
+static void _cacheWitness(const bip44_path_t* path, const uint8_t* signature, size_t signatureSize)
+{
+	ASSERT(signatureSize == ED25519_SIGNATURE_LENGTH);
+	ASSERT(WITNESS_CTX->cache.nextEntry < SIGN_TX_WITNESS_CACHE_SIZE);
+
+	sign_tx_witness_cache_entry_t* entry = &WITNESS_CTX->cache.entries[WITNESS_CTX->cache.nextEntry];
+	entry->path = *path;
+	memmove(entry->signature, signature, ED25519_SIGNATURE_LENGTH);
+
+	WITNESS_CTX->cache.nextEntry = (WITNESS_CTX->cache.nextEntry + 1) % SIGN_TX_WITNESS_CACHE_SIZE;
+	if (WITNESS_CTX->cache.numEntries < SIGN_TX_WITNESS_CACHE_SIZE) {
+		WITNESS_CTX->cache.numEntries++;
+	}
+}
+
 __noinline_due_to_stack__
 static void signTx_handleWitnessAPDU(uint8_t p2, const uint8_t* wireDataBuffer, size_t wireDataSize)
 {
@@ -2461,45 +2633,49 @@ static void signTx_handleWitnessAPDU(uint8_t p2, const uint8_t* wireDataBuffer,
 		CHECK_STAGE(SIGN_STAGE_WITNESSES);
 		TRACE("Witness no. %d out of %d", WITNESS_CTX->currentWitness + 1, ctx->numWitnesses);
 		ASSERT(WITNESS_CTX->currentWitness < ctx->numWitnesses);
-
-		VALIDATE(p2 == P2_UNUSED, ERR_INVALID_REQUEST_PARAMETERS);
 	}
 
-	explicit_bzero(&WITNESS_CTX->stageData.witness, SIZEOF(WITNESS_CTX->stageData.witness));
+	explicit_bzero(&WITNESS_CTX->stageData, SIZEOF(WITNESS_CTX->stageData));
 
-	{
-		// parse
-		TRACE_BUFFER(wireDataBuffer, wireDataSize);
+	_parseWitnessPaths(p2, wireDataBuffer, wireDataSize);
 
-		size_t parsedSize = bip44_parseFromWire(&WITNESS_CTX->stageData.witness.path, wireDataBuffer, wireDataSize);
-		VALIDATE(parsedSize == wireDataSize, ERR_INVALID_DATA);
+	security_policy_t policy = POLICY_ALLOW_WITHOUT_PROMPT;
+	for (size_t i = 0; i < WITNESS_CTX->stageData.numWitnesses; i++) {
+		security_policy_t witnessPolicy = policyForSignTxWitness(
+		                ctx->commonTxData.txSigningMode,
+		                &WITNESS_CTX->stageData.paths[i],
+		                ctx->includeMint,
+		                ctx->poolOwnerByPath ? &ctx->poolOwnerPath : NULL
+		                                  );
+		TRACE("Policy: %d", (int) witnessPolicy);
+		ENSURE_NOT_DENIED(witnessPolicy);
 
-		TRACE();
-		BIP44_PRINTF(&WITNESS_CTX->stageData.witness.path);
-		PRINTF("\n");
+		policy = combineBatchPolicies(policy, witnessPolicy);
 	}
 
-	security_policy_t policy = policyForSignTxWitness(
-	                                   ctx->commonTxData.txSigningMode,
-	                                   &WITNESS_CTX->stageData.witness.path,
-	                                   ctx->includeMint,
-	                                   ctx->poolOwnerByPath ? &ctx->poolOwnerPath : NULL
-	                           );
-	TRACE("Policy: %d", (int) policy);
-	ENSURE_NOT_DENIED(policy);
-
 	{
-		// compute witness
+		// compute witnesses
 		TRACE("getWitness");
 		TRACE("TX HASH");
 		TRACE_BUFFER(ctx->txHash, SIZEOF(ctx->txHash));
 		TRACE("END TX HASH");
 
-		getWitness(
-		        &WITNESS_CTX->stageData.witness.path,
-		        ctx->txHash, SIZEOF(ctx->txHash),
-		        WITNESS_CTX->stageData.witness.signature, SIZEOF(WITNESS_CTX->stageData.witness.signature)
-		);
+		for (size_t i = 0; i < WITNESS_CTX->stageData.numWitnesses; i++) {
+			const bip44_path_t* path = &WITNESS_CTX->stageData.paths[i];
+			uint8_t* signature = WITNESS_CTX->stageData.signatures[i];
+			const size_t signatureSize = SIZEOF(WITNESS_CTX->stageData.signatures[i]);
+
+			if (_getCachedWitness(path, signature, signatureSize)) {
+				TRACE("Witness taken from cache");
+				continue;
+			}
+			getWitness(
+			        &WITNESS_CTX->stageData.paths[i],
+			        ctx->txHash, SIZEOF(ctx->txHash),
+			        signature, signatureSize
+			);
+			_cacheWitness(path, signature, signatureSize);
+		}
 	}
 
 	{
@@ -2518,6 +2694,56 @@ static void signTx_handleWitnessAPDU(uint8_t p2, const uint8_t* wireDataBuffer,
 }
 
 
+// ============================== RESUME SESSION ==============================
+
+#ifdef APP_FEATURE_SIGN_TX_SESSION
+
+// starts the witness stage of the tx confirmed in a previous SIGN_TX instruction
+__noinline_due_to_stack__
+static void signTx_handleResumeSessionAPDU(uint8_t p2, const uint8_t* wireDataBuffer, size_t wireDataSize)
+{
+	TRACE_STACK_USAGE();
+	{
+		// sanity checks
+		CHECK_STAGE(SIGN_STAGE_INIT);
+
+		VALIDATE(p2 == P2_UNUSED, ERR_INVALID_REQUEST_PARAMETERS);
+	}
+
+	{
+		// parse data
+		TRACE_BUFFER(wireDataBuffer, wireDataSize);
+
+		struct {
+			uint8_t sessionId[SIGN_TX_SESSION_ID_LENGTH];
+			uint8_t numWitnesses[4];
+		}* wireData = (void*) wireDataBuffer;
+
+		VALIDATE(wireDataSize == SIZEOF(*wireData), ERR_INVALID_DATA);
+
+		const uint32_t numWitnesses = u4be_read(wireData->numWitnesses);
+		VALIDATE(numWitnesses > 0, ERR_INVALID_DATA);
+		VALIDATE(numWitnesses <= UINT16_MAX, ERR_INVALID_DATA);
+
+		const bool isResumed = signTxSession_resume(wireData->sessionId, SIZEOF(wireData->sessionId));
+		VALIDATE(isResumed, ERR_INVALID_STATE);
+
+		ASSERT_TYPE(ctx->numWitnesses, uint16_t);
+		ctx->numWitnesses = (uint16_t) numWitnesses;
+	}
+
+	// the tx has been confirmed by the user when the session was opened
+	io_send_buf(SUCCESS, ctx->txHash, SIZEOF(ctx->txHash));
+	#ifdef HAVE_BAGL
+	ui_displayBusy(); // displays dots, called only after I/O to avoid freezing
+	#endif // HAVE_BAGL
+
+	ctx->stage = SIGN_STAGE_CONFIRM;
+	tx_advanceStage();
+}
+
+#endif // APP_FEATURE_SIGN_TX_SESSION
+
 // ============================== MAIN HANDLER ==============================
 
 typedef void subhandler_fn_t(uint8_t p2, const uint8_t* dataBuffer, size_t dataSize);
@@ -2556,6 +2782,9 @@ static subhandler_fn_t* lookup_subhandler(uint8_t p1)
 		CASE(0x16, signTx_handleDonationAPDU);
 		CASE(0x0a, signTx_handleConfirmAPDU);
 		CASE(0x0f, signTx_handleWitnessAPDU);
+		#ifdef APP_FEATURE_SIGN_TX_SESSION
+		CASE(SIGN_TX_P1_RESUME_SESSION, signTx_handleResumeSessionAPDU);
+		#endif // APP_FEATURE_SIGN_TX_SESSION
 		DEFAULT(NULL)
 #undef   CASE
 #undef   DEFAULT
@@ -13,6 +13,7 @@
 #include "signTxPoolRegistration.h"
 #include "signTxCVoteRegistration.h"
 #include "signTxAuxData.h"
+#include "keyHashCache.h"
 
 // the signing mode significantly affects restrictions on tx being signed
 typedef enum {
@@ -68,6 +69,32 @@ enum {
 	SIGN_MAX_VOTING_PROCEDURES = 1, // we only support a single vote per tx
 };
 
+// P2 values for APDUs which may carry several items of the same kind
+enum {
+	SIGN_TX_P2_SINGLE = P2_UNUSED,
+	SIGN_TX_P2_BATCH = 0x01,
+};
+
+#ifdef APP_FEATURE_SIGN_TX_SESSION
+// P2 of the confirm APDU asking for a session, see signTxSession.h
+#define SIGN_TX_CONFIRM_P2_OPEN_SESSION 0x01
+#endif // APP_FEATURE_SIGN_TX_SESSION
+
+enum {
+	// limited by the stage data: another path and signature would make
+	// the witness context larger than the tx body context on APP_XS
+	// (the response APDU would still fit 4 signatures)
+	SIGN_TX_WITNESS_BATCH_MAX = 3,
+	// limited by the size of the stage data union, not by the APDU size
+	SIGN_TX_INPUT_BATCH_MAX = 6,
+	SIGN_TX_WITHDRAWAL_BATCH_MAX = 5,
+	SIGN_TX_REQUIRED_SIGNER_BATCH_MAX = 7,
+};
+
+// an entry takes 88 B; 6 of them fill the witness context up to
+// the tx body context it shares the union with
+#define SIGN_TX_WITNESS_CACHE_SIZE 6
+
 #define UI_INPUT_LABEL_SIZE 20
 
 typedef struct {
@@ -151,21 +178,27 @@ typedef struct {
 } sign_tx_certificate_data_t;
 
 typedef struct {
-	tx_input_t input_data;
+	// inputs received in the current APDU (just one unless packed)
+	tx_input_t inputs[SIGN_TX_INPUT_BATCH_MAX];
+	uint8_t numInputs;
+	uint8_t currentDisplayedInput;
 	char label[UI_INPUT_LABEL_SIZE];
-} sign_tx_transaction_input_t;
-
-typedef struct {
-	bip44_path_t path;
-	uint8_t signature[ED25519_SIGNATURE_LENGTH];
-} sign_tx_witness_data_t;
+} sign_tx_transaction_inputs_t;
 
 typedef struct {
 	ext_credential_t stakeCredential;
 	uint64_t amount;
-	uint8_t previousRewardAccount[REWARD_ACCOUNT_SIZE];
 } sign_tx_withdrawal_data_t;
 
+typedef struct {
+	// withdrawals received in the current APDU (just one unless packed)
+	sign_tx_withdrawal_data_t withdrawals[SIGN_TX_WITHDRAWAL_BATCH_MAX];
+	uint8_t numWithdrawals;
+	uint8_t currentDisplayedWithdrawal;
+	// kept across APDUs for the canonical ordering check
+	uint8_t previousRewardAccount[REWARD_ACCOUNT_SIZE];
+} sign_tx_withdrawals_t;
+
 typedef struct {
 	bool auxDataReceived;
 	aux_data_type_t auxDataType;
@@ -189,6 +222,13 @@ typedef struct {
 	};
 } sign_tx_required_signer_t;
 
+typedef struct {
+	// required signers received in the current APDU (just one unless packed)
+	sign_tx_required_signer_t requiredSigners[SIGN_TX_REQUIRED_SIGNER_BATCH_MAX];
+	uint8_t numRequiredSigners;
+	uint8_t currentDisplayedRequiredSigner;
+} sign_tx_required_signers_t;
+
 // voters are extended to allow key derivation paths
 typedef enum {
 	EXT_VOTER_COMMITTEE_HOT_KEY_HASH = 0,
@@ -240,14 +280,14 @@ typedef struct {
 	bool donationReceived;
 
 	union {
-		sign_tx_transaction_input_t input;
+		sign_tx_transaction_inputs_t inputs;
 		uint64_t fee;
 		uint64_t ttl;
 		sign_tx_certificate_data_t certificate;
-		sign_tx_withdrawal_data_t withdrawal;
+		sign_tx_withdrawals_t withdrawals;
 		uint64_t validityIntervalStart;
 		uint8_t scriptDataHash[SCRIPT_DATA_HASH_LENGTH];
-		sign_tx_required_signer_t requiredSigner;
+		sign_tx_required_signers_t requiredSigners;
 		uint64_t totalCollateral;
 		sign_tx_voting_procedure_t votingProcedure;
 		uint64_t treasury;
@@ -265,10 +305,34 @@ typedef struct {
 	} stageContext;
 } ins_sign_tx_body_context_t;
 
+#ifdef APP_FEATURE_TOKEN_MINTING
+// the packed tokens buffer must not make the mint context the largest stage context
+STATIC_ASSERT(sizeof(mint_context_t) <= sizeof(output_context_t), "mint_context_t outgrows output_context_t");
+#endif // APP_FEATURE_TOKEN_MINTING
+
+typedef struct {
+	bip44_path_t path;
+	uint8_t signature[ED25519_SIGNATURE_LENGTH];
+} sign_tx_witness_cache_entry_t;
+
 typedef struct {
 	uint16_t currentWitness;
+
+	// witnesses already produced for the tx hash, repeated paths are not signed again
 	struct {
-		sign_tx_witness_data_t witness;
+		sign_tx_witness_cache_entry_t entries[SIGN_TX_WITNESS_CACHE_SIZE];
+		uint8_t numEntries;
+		// the oldest entry, overwritten when the cache is full
+		uint8_t nextEntry;
+	} cache;
+
+	struct {
+		// witnesses requested in the current APDU
+		uint8_t numWitnesses;
+		uint8_t currentDisplayedWitness;
+		bip44_path_t paths[SIGN_TX_WITNESS_BATCH_MAX];
+		// kept contiguous so that they can be sent in a single response
+		uint8_t signatures[SIGN_TX_WITNESS_BATCH_MAX][ED25519_SIGNATURE_LENGTH];
 	} stageData;
 } ins_sign_tx_witness_context_t;
 
@@ -311,8 +375,17 @@ typedef struct {
 	bool poolOwnerByPath;
 	bip44_path_t poolOwnerPath;
 
+	#ifdef APP_FEATURE_KEY_HASH_CACHE
+	// see tx_pathToKeyHash()
+	key_hash_cache_t keyHashCache;
+	#endif // APP_FEATURE_KEY_HASH_CACHE
+
 	bool shouldDisplayTxid; // long bytestrings (e.g. datums in outputs) are better verified indirectly
 
+	#ifdef APP_FEATURE_SIGN_TX_SESSION
+	bool openSession; // requested in the confirm APDU
+	#endif // APP_FEATURE_SIGN_TX_SESSION
+
 	int ui_step;
 	void (*ui_advanceState)();
 } ins_sign_tx_context_t;
@@ -437,8 +437,9 @@ size_t _destinationToAddress(
 
 	switch (destination->type) {
 	case DESTINATION_DEVICE_OWNED:
-		addressSize = deriveAddress(
+		addressSize = deriveAddressWithKeyHashFn(
 		                      &destination->params,
+		                      tx_pathToKeyHash,
 		                      addressBuffer,
 		                      addressBufferSize
 		              );
@@ -88,6 +88,7 @@ static void signTxMint_handleAssetGroupAPDU(const uint8_t* wireDataBuffer, size_
 
 		STATIC_ASSERT(SIZEOF(tokenGroup->policyId) >= MINTING_POLICY_ID_SIZE, "wrong policyId length");
 		memmove(tokenGroup->policyId, candidatePolicyId, MINTING_POLICY_ID_SIZE);
+		tokenGroup->isPolicyInRegistry = tokens_isPolicyInRegistry(tokenGroup->policyId, SIZEOF(tokenGroup->policyId));
 
 		uint32_t numTokens = parse_u4be(&view);
 		VALIDATE(numTokens <= OUTPUT_TOKENS_IN_GROUP_MAX, ERR_INVALID_DATA);
@@ -114,6 +115,33 @@ static void signTxMint_handleAssetGroupAPDU(const uint8_t* wireDataBuffer, size_
 	signTxMint_handleAssetGroup_ui_runStep();
 }
 
+static void selectTokenUIStep()
+{
+	mint_context_t* subctx = accessSubcontext();
+
+	switch (subctx->mintSecurityPolicy) {
+#define  CASE(POLICY, UI_STEP) case POLICY: {subctx->ui_step=UI_STEP; break;}
+		CASE(POLICY_SHOW_BEFORE_RESPONSE, HANDLE_TOKEN_STEP_DISPLAY_NAME);
+		CASE(POLICY_ALLOW_WITHOUT_PROMPT, HANDLE_TOKEN_STEP_RESPOND);
+#undef   CASE
+	default:
+		THROW(ERR_NOT_IMPLEMENTED);
+	}
+}
+
+static void addTokenToTx()
+{
+	mint_context_t* subctx = accessSubcontext();
+
+	TRACE("Adding token to tx hash");
+	txHashBuilder_addMint_token(
+	        &BODY_CTX->txHashBuilder,
+	        subctx->stateData.token.assetNameBytes, subctx->stateData.token.assetNameSize,
+	        subctx->stateData.token.amount
+	);
+	TRACE();
+}
+
 static void signTxMint_handleTokenAPDU(const uint8_t* wireDataBuffer, size_t wireDataSize)
 {
 	{
@@ -151,27 +179,107 @@ static void signTxMint_handleTokenAPDU(const uint8_t* wireDataBuffer, size_t wir
 		VALIDATE(view_remainingSize(&view) == 0, ERR_INVALID_DATA);
 	}
 
-	{
-		// select UI step
-		switch (subctx->mintSecurityPolicy) {
-#define  CASE(POLICY, UI_STEP) case POLICY: {subctx->ui_step=UI_STEP; break;}
-			CASE(POLICY_SHOW_BEFORE_RESPONSE, HANDLE_TOKEN_STEP_DISPLAY_NAME);
-			CASE(POLICY_ALLOW_WITHOUT_PROMPT, HANDLE_TOKEN_STEP_RESPOND);
-#undef   CASE
-		default:
-			THROW(ERR_NOT_IMPLEMENTED);
+	selectTokenUIStep();
+	addTokenToTx();
+
+	signTxMint_handleToken_ui_runStep();
+}
+
+// a token record of a packed APDU: asset name size (1 B), asset name, amount (8 B)
+static void parsePackedToken(read_view_t* view, mint_token_amount_t* token)
+{
+	const size_t assetNameSize = parse_u1be(view);
+	VALIDATE(assetNameSize <= ASSET_NAME_SIZE_MAX, ERR_INVALID_DATA);
+	STATIC_ASSERT(SIZEOF(token->assetNameBytes) >= ASSET_NAME_SIZE_MAX, "wrong asset name buffer size");
+	view_parseBuffer(token->assetNameBytes, view, assetNameSize);
+	token->assetNameSize = assetNameSize;
+
+	token->amount = parse_int64be(view);
+	TRACE_INT64(token->amount);
+}
+
+// the records of the packed APDU are only validated here, processed one by one later
+static void validatePackedTokens(read_view_t view, uint8_t numPackedTokens)
+{
+	mint_context_t* subctx = accessSubcontext();
+
+	mint_token_amount_t previous = subctx->stateData.token;
+	for (size_t i = 0; i < numPackedTokens; i++) {
+		mint_token_amount_t candidate;
+		explicit_bzero(&candidate, SIZEOF(candidate));
+		parsePackedToken(&view, &candidate);
+
+		if (subctx->currentToken + i > 0) {
+			VALIDATE(cbor_mapKeyFulfillsCanonicalOrdering(
+			                 previous.assetNameBytes, previous.assetNameSize,
+			                 candidate.assetNameBytes, candidate.assetNameSize
+			         ), ERR_INVALID_DATA);
 		}
+		previous = candidate;
 	}
+	VALIDATE(view_remainingSize(&view) == 0, ERR_INVALID_DATA);
+}
+
+// moves to the next token of the packed APDU, the previous one must have been processed
+void signTxMint_processNextPackedToken()
+{
+	mint_context_t* subctx = accessSubcontext();
+	ASSERT(subctx->stateData.numPackedTokens > 0);
+	ASSERT(subctx->stateData.packedTokensOffset < subctx->stateData.packedTokensSize);
+	ASSERT(subctx->stateData.packedTokensSize <= SIZEOF(subctx->stateData.packedTokens));
+
+	read_view_t view = make_read_view(
+	                           subctx->stateData.packedTokens + subctx->stateData.packedTokensOffset,
+	                           subctx->stateData.packedTokens + subctx->stateData.packedTokensSize
+	                   );
+	parsePackedToken(&view, &subctx->stateData.token);
+	subctx->stateData.packedTokensOffset += view_processedSize(&view);
+	subctx->stateData.numPackedTokens--;
+
+	selectTokenUIStep();
+	addTokenToTx();
+}
 
+static void signTxMint_handlePackedTokensAPDU(const uint8_t* wireDataBuffer, size_t wireDataSize)
+{
 	{
-		// add token group to tx
-		TRACE("Adding token group hash to tx hash");
-		txHashBuilder_addMint_token(
-		        &BODY_CTX->txHashBuilder,
-		        subctx->stateData.token.assetNameBytes, subctx->stateData.token.assetNameSize,
-		        subctx->stateData.token.amount
-		);
-		TRACE();
+		// sanity checks
+		CHECK_STATE(STATE_MINT_TOKEN);
+	}
+	mint_context_t* subctx = accessSubcontext();
+	{
+		// parse data
+		TRACE_BUFFER(wireDataBuffer, wireDataSize);
+		read_view_t view = make_read_view(wireDataBuffer, wireDataBuffer + wireDataSize);
+
+		const uint8_t numPackedTokens = parse_u1be(&view);
+		VALIDATE(numPackedTokens > 0, ERR_INVALID_DATA);
+		ASSERT(subctx->currentToken < subctx->numTokens);
+		VALIDATE(numPackedTokens <= subctx->numTokens - subctx->currentToken, ERR_INVALID_DATA);
+
+		validatePackedTokens(view, numPackedTokens);
+
+		// the first token is processed right away, the rest is kept
+		parsePackedToken(&view, &subctx->stateData.token);
+
+		const size_t packedTokensSize = view_remainingSize(&view);
+		VALIDATE(packedTokensSize <= SIZEOF(subctx->stateData.packedTokens), ERR_INVALID_DATA);
+		view_parseBuffer(subctx->stateData.packedTokens, &view, packedTokensSize);
+		subctx->stateData.packedTokensSize = packedTokensSize;
+		subctx->stateData.packedTokensOffset = 0;
+		subctx->stateData.numPackedTokens = numPackedTokens - 1;
+	}
+
+	selectTokenUIStep();
+	addTokenToTx();
+
+	if (subctx->ui_step == HANDLE_TOKEN_STEP_RESPOND) {
+		// nothing is shown, so there is no reason to wait for the UI
+		while (subctx->stateData.numPackedTokens > 0) {
+			ASSERT(subctx->currentToken < subctx->numTokens);
+			subctx->currentToken++;
+			signTxMint_processNextPackedToken();
+		}
 	}
 
 	signTxMint_handleToken_ui_runStep();
@@ -214,6 +322,8 @@ enum {
 	APDU_INSTRUCTION_ASSET_GROUP = 0x31,
 	APDU_INSTRUCTION_TOKEN = 0x32,
 	APDU_INSTRUCTION_CONFIRM = 0x33,
+	// the same value as for outputs
+	APDU_INSTRUCTION_PACKED_TOKENS = 0x39,
 };
 
 bool signTxMint_isValidInstruction(uint8_t p2)
@@ -222,6 +332,7 @@ bool signTxMint_isValidInstruction(uint8_t p2)
 	case APDU_INSTRUCTION_TOP_LEVEL_DATA:
 	case APDU_INSTRUCTION_ASSET_GROUP:
 	case APDU_INSTRUCTION_TOKEN:
+	case APDU_INSTRUCTION_PACKED_TOKENS:
 	case APDU_INSTRUCTION_CONFIRM:
 		return true;
 
@@ -257,6 +368,10 @@ void signTxMint_handleAPDU(uint8_t p2, const uint8_t* wireDataBuffer, size_t wir
 		signTxMint_handleTokenAPDU(wireDataBuffer, wireDataSize);
 		break;
 
+	case APDU_INSTRUCTION_PACKED_TOKENS:
+		signTxMint_handlePackedTokensAPDU(wireDataBuffer, wireDataSize);
+		break;
+
 	case APDU_INSTRUCTION_CONFIRM:
 		signTxMint_handleConfirmAPDU(wireDataBuffer, wireDataSize);
 		break;
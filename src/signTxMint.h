@@ -44,6 +44,12 @@ typedef struct {
 		struct {
 			token_group_t tokenGroup;
 			mint_token_amount_t token;
+
+			// the records of a packed APDU following the token being processed
+			uint8_t numPackedTokens;
+			size_t packedTokensSize;
+			size_t packedTokensOffset;
+			uint8_t packedTokens[PACKED_TOKENS_BUFFER_SIZE];
 		};
 	} stateData;
 
@@ -57,6 +63,8 @@ void signTxMint_handleAPDU(uint8_t p2, const uint8_t* wireDataBuffer, size_t wir
 
 bool signTxMint_isFinished();
 
+void signTxMint_processNextPackedToken();
+
 #endif // APP_FEATURE_TOKEN_MINTING
 
 #endif // H_CARDANO_APP_SIGN_TX_MINT
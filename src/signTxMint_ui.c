@@ -167,9 +167,18 @@ void signTxMint_handleToken_ui_runStep()
 		#endif // HAVE_BAGL
 	}
 	UI_STEP(HANDLE_TOKEN_STEP_RESPOND) {
+		ASSERT(subctx->currentToken < subctx->numTokens);
+
+		if (subctx->stateData.numPackedTokens > 0) {
+			// the APDU is answered once all its tokens have been shown
+			subctx->currentToken++;
+			signTxMint_processNextPackedToken();
+			ASSERT(subctx->ui_step == HANDLE_TOKEN_STEP_DISPLAY_NAME);
+			UI_STEP_JUMP(HANDLE_TOKEN_STEP_DISPLAY_NAME);
+		}
+
 		respondSuccessEmptyMsg();
 
-		ASSERT(subctx->currentToken < subctx->numTokens);
 		subctx->currentToken++;
 
 		if (subctx->currentToken == subctx->numTokens) {
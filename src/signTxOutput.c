@@ -251,8 +251,9 @@ static void handleOutput_addressParams()
 	{
 		// add to tx
 		uint8_t addressBuffer[MAX_ADDRESS_SIZE] = {0};
-		size_t addressSize = deriveAddress(
+		size_t addressSize = deriveAddressWithKeyHashFn(
 		                             &subctx->stateData.destination.params,
+		                             tx_pathToKeyHash,
 		                             addressBuffer,
 		                             SIZEOF(addressBuffer)
 		                     );
@@ -302,6 +303,23 @@ static bool _isValidOutputSerializationFormat(tx_output_serialization_format_t f
 	}
 }
 
+// format, destination and ADA amount, shared by the top level data and simple outputs
+static void _parseOutputBase(read_view_t* view)
+{
+	output_context_t* subctx = accessSubcontext();
+
+	subctx->serializationFormat = parse_u1be(view);
+	TRACE("Output serialization format %d", (int) subctx->serializationFormat);
+	VALIDATE(_isValidOutputSerializationFormat(subctx->serializationFormat), ERR_INVALID_DATA);
+
+	view_parseDestination(view, &subctx->stateData.destination);
+
+	uint64_t adaAmount = parse_u8be(view);
+	subctx->stateData.adaAmount = adaAmount;
+	TRACE("Amount: %u.%06u", (unsigned) (adaAmount / 1000000), (unsigned)(adaAmount % 1000000));
+	VALIDATE(adaAmount < LOVELACE_MAX_SUPPLY, ERR_INVALID_DATA);
+}
+
 static void parseTopLevelData(const uint8_t* wireDataBuffer, size_t wireDataSize)
 {
 	{
@@ -316,16 +334,7 @@ static void parseTopLevelData(const uint8_t* wireDataBuffer, size_t wireDataSize
 
 		read_view_t view = make_read_view(wireDataBuffer, wireDataBuffer + wireDataSize);
 
-		subctx->serializationFormat = parse_u1be(&view);
-		TRACE("Output serialization format %d", (int) subctx->serializationFormat);
-		VALIDATE(_isValidOutputSerializationFormat(subctx->serializationFormat), ERR_INVALID_DATA);
-
-		view_parseDestination(&view, &subctx->stateData.destination);
-
-		uint64_t adaAmount = parse_u8be(&view);
-		subctx->stateData.adaAmount = adaAmount;
-		TRACE("Amount: %u.%06u", (unsigned) (adaAmount / 1000000), (unsigned)(adaAmount % 1000000));
-		VALIDATE(adaAmount < LOVELACE_MAX_SUPPLY, ERR_INVALID_DATA);
+		_parseOutputBase(&view);
 
 		uint32_t numAssetGroups = parse_u4be(&view);
 		TRACE("num asset groups %u", numAssetGroups);
@@ -474,8 +483,9 @@ static void handleCollateralOutput_addressParams()
 	{
 		// add to tx
 		uint8_t addressBuffer[MAX_ADDRESS_SIZE] = {0};
-		size_t addressSize = deriveAddress(
+		size_t addressSize = deriveAddressWithKeyHashFn(
 		                             &subctx->stateData.destination.params,
+		                             tx_pathToKeyHash,
 		                             addressBuffer,
 		                             SIZEOF(addressBuffer)
 		                     );
@@ -535,6 +545,71 @@ static void handleTopLevelDataAPDU_collateralOutput(const uint8_t* wireDataBuffe
 		ASSERT(false);
 	};
 }
+
+// ============================== SIMPLE OUTPUT ==============================
+
+// an output without tokens, inline datum and reference script,
+// the datum hash (if any) is given together with the top level data
+static void parseSimpleOutput(const uint8_t* wireDataBuffer, size_t wireDataSize)
+{
+	{
+		// safety checks
+		CHECK_STATE(STATE_OUTPUT_TOP_LEVEL_DATA);
+	}
+
+	output_context_t* subctx = accessSubcontext();
+	{
+		// parse all APDU data
+		TRACE_BUFFER(wireDataBuffer, wireDataSize);
+
+		read_view_t view = make_read_view(wireDataBuffer, wireDataBuffer + wireDataSize);
+
+		_parseOutputBase(&view);
+
+		subctx->numAssetGroups = 0;
+		subctx->includeRefScript = false;
+
+		subctx->includeDatum = signTx_parseIncluded(parse_u1be(&view));
+		TRACE("includeDatum = %d", (int) subctx->includeDatum);
+
+		if (subctx->includeDatum) {
+			STATIC_ASSERT(SIZEOF(subctx->stateData.simpleOutputDatumHash) == OUTPUT_DATUM_HASH_LENGTH, "wrong datum hash length");
+			view_parseBuffer(subctx->stateData.simpleOutputDatumHash, &view, OUTPUT_DATUM_HASH_LENGTH);
+
+			// it's easier to verify all Plutus-related things via txid all at once
+			ctx->shouldDisplayTxid = true;
+		}
+
+		VALIDATE(view_remainingSize(&view) == 0, ERR_INVALID_DATA);
+	}
+}
+
+static void handleSimpleOutputAPDU(const uint8_t* wireDataBuffer, size_t wireDataSize)
+{
+	CHECK_STATE(STATE_OUTPUT_TOP_LEVEL_DATA);
+
+	parseSimpleOutput(wireDataBuffer, wireDataSize);
+
+	output_context_t* subctx = accessSubcontext();
+	subctx->isSimpleOutput = true;
+
+	// the top level data are processed as usual,
+	// the remaining items are chained by tx_output_respondAndAdvanceState
+	switch (subctx->stateData.destination.type) {
+
+	case DESTINATION_THIRD_PARTY:
+		handleOutput_addressBytes();
+		break;
+
+	case DESTINATION_DEVICE_OWNED:
+		handleOutput_addressParams();
+		break;
+
+	default:
+		ASSERT(false);
+	};
+}
+
 // ============================== ASSET GROUP ==============================
 
 static void handleAssetGroupAPDU(const uint8_t* wireDataBuffer, size_t wireDataSize)
@@ -564,6 +639,7 @@ static void handleAssetGroupAPDU(const uint8_t* wireDataBuffer, size_t wireDataS
 
 		STATIC_ASSERT(SIZEOF(tokenGroup->policyId) >= MINTING_POLICY_ID_SIZE, "wrong policyId length");
 		memmove(tokenGroup->policyId, candidatePolicyId, MINTING_POLICY_ID_SIZE);
+		tokenGroup->isPolicyInRegistry = tokens_isPolicyInRegistry(tokenGroup->policyId, SIZEOF(tokenGroup->policyId));
 
 		uint32_t numTokens = parse_u4be(&view);
 		VALIDATE(numTokens <= OUTPUT_TOKENS_IN_GROUP_MAX, ERR_INVALID_DATA);
@@ -611,6 +687,51 @@ static void handleAssetGroupAPDU(const uint8_t* wireDataBuffer, size_t wireDataS
 
 // ============================== TOKEN ==============================
 
+static void addTokenToTx()
+{
+	output_context_t* subctx = accessSubcontext();
+
+	TRACE("Adding token to tx hash");
+	switch (ctx->stage) {
+
+	case SIGN_STAGE_BODY_OUTPUTS_SUBMACHINE:
+		TRACE();
+		txHashBuilder_addOutput_token(
+		        &BODY_CTX->txHashBuilder,
+		        subctx->stateData.token.assetNameBytes, subctx->stateData.token.assetNameSize,
+		        subctx->stateData.token.amount
+		);
+		break;
+
+	case SIGN_STAGE_BODY_COLLATERAL_OUTPUT_SUBMACHINE:
+		TRACE();
+		txHashBuilder_addCollateralOutput_token(
+		        &BODY_CTX->txHashBuilder,
+		        subctx->stateData.token.assetNameBytes, subctx->stateData.token.assetNameSize,
+		        subctx->stateData.token.amount
+		);
+		break;
+
+	default:
+		ASSERT(false);
+	}
+}
+
+static void selectTokenUIStep()
+{
+	output_context_t* subctx = accessSubcontext();
+
+	switch (subctx->outputTokensSecurityPolicy) {
+#define  CASE(POLICY, UI_STEP) case POLICY: {subctx->ui_step=UI_STEP; break;}
+		CASE(POLICY_PROMPT_WARN_UNUSUAL, HANDLE_TOKEN_STEP_DISPLAY_NAME);
+		CASE(POLICY_SHOW_BEFORE_RESPONSE, HANDLE_TOKEN_STEP_DISPLAY_NAME);
+		CASE(POLICY_ALLOW_WITHOUT_PROMPT, HANDLE_TOKEN_STEP_RESPOND);
+#undef   CASE
+	default:
+		THROW(ERR_NOT_IMPLEMENTED);
+	}
+}
+
 static void handleTokenAPDU(const uint8_t* wireDataBuffer, size_t wireDataSize)
 {
 	{
@@ -647,47 +768,116 @@ static void handleTokenAPDU(const uint8_t* wireDataBuffer, size_t wireDataSize)
 
 		VALIDATE(view_remainingSize(&view) == 0, ERR_INVALID_DATA);
 	}
-	{
-		// add token group to tx
-		TRACE("Adding token group hash to tx hash");
-		switch (ctx->stage) {
 
-		case SIGN_STAGE_BODY_OUTPUTS_SUBMACHINE:
-			TRACE();
-			txHashBuilder_addOutput_token(
-			        &BODY_CTX->txHashBuilder,
-			        subctx->stateData.token.assetNameBytes, subctx->stateData.token.assetNameSize,
-			        subctx->stateData.token.amount
-			);
-			break;
+	addTokenToTx();
 
-		case SIGN_STAGE_BODY_COLLATERAL_OUTPUT_SUBMACHINE:
-			TRACE();
-			txHashBuilder_addCollateralOutput_token(
-			        &BODY_CTX->txHashBuilder,
-			        subctx->stateData.token.assetNameBytes, subctx->stateData.token.assetNameSize,
-			        subctx->stateData.token.amount
-			);
-			break;
+	selectTokenUIStep();
+	handleToken_ui_runStep();
+}
 
-		default:
-			ASSERT(false);
+// ============================== PACKED TOKENS ==============================
+
+// a token record of a packed APDU: asset name size (1 B), asset name, amount (8 B)
+static void parsePackedToken(read_view_t* view, output_token_amount_t* token)
+{
+	const size_t assetNameSize = parse_u1be(view);
+	VALIDATE(assetNameSize <= ASSET_NAME_SIZE_MAX, ERR_INVALID_DATA);
+	STATIC_ASSERT(SIZEOF(token->assetNameBytes) >= ASSET_NAME_SIZE_MAX, "wrong asset name buffer size");
+	view_parseBuffer(token->assetNameBytes, view, assetNameSize);
+	token->assetNameSize = assetNameSize;
+
+	token->amount = parse_u8be(view);
+	TRACE_UINT64(token->amount);
+}
+
+// the records of the packed APDU are only validated here, processed one by one later
+static void validatePackedTokens(read_view_t view, uint8_t numPackedTokens)
+{
+	output_context_t* subctx = accessSubcontext();
+
+	output_token_amount_t previous = subctx->stateData.token;
+	for (size_t i = 0; i < numPackedTokens; i++) {
+		output_token_amount_t candidate;
+		explicit_bzero(&candidate, SIZEOF(candidate));
+		parsePackedToken(&view, &candidate);
+
+		if (subctx->stateData.currentToken + i > 0) {
+			VALIDATE(cbor_mapKeyFulfillsCanonicalOrdering(
+			                 previous.assetNameBytes, previous.assetNameSize,
+			                 candidate.assetNameBytes, candidate.assetNameSize
+			         ), ERR_INVALID_DATA);
 		}
+		previous = candidate;
 	}
+	VALIDATE(view_remainingSize(&view) == 0, ERR_INVALID_DATA);
+}
+
+// moves to the next token of the packed APDU, the previous one must have been processed
+void tx_output_processNextPackedToken()
+{
+	output_context_t* subctx = accessSubcontext();
+	ASSERT(subctx->stateData.numPackedTokens > 0);
+	ASSERT(subctx->stateData.packedTokensOffset < subctx->stateData.packedTokensSize);
+	ASSERT(subctx->stateData.packedTokensSize <= SIZEOF(subctx->stateData.packedTokens));
+
+	read_view_t view = make_read_view(
+	                           subctx->stateData.packedTokens + subctx->stateData.packedTokensOffset,
+	                           subctx->stateData.packedTokens + subctx->stateData.packedTokensSize
+	                   );
+	parsePackedToken(&view, &subctx->stateData.token);
+	subctx->stateData.packedTokensOffset += view_processedSize(&view);
+	subctx->stateData.numPackedTokens--;
+
+	addTokenToTx();
+	selectTokenUIStep();
+}
+
+static void handlePackedTokensAPDU(const uint8_t* wireDataBuffer, size_t wireDataSize)
+{
 	{
-		// select UI step
-		switch (subctx->outputTokensSecurityPolicy) {
-#define  CASE(POLICY, UI_STEP) case POLICY: {subctx->ui_step=UI_STEP; break;}
-			CASE(POLICY_PROMPT_WARN_UNUSUAL, HANDLE_TOKEN_STEP_DISPLAY_NAME);
-			CASE(POLICY_SHOW_BEFORE_RESPONSE, HANDLE_TOKEN_STEP_DISPLAY_NAME);
-			CASE(POLICY_ALLOW_WITHOUT_PROMPT, HANDLE_TOKEN_STEP_RESPOND);
-#undef   CASE
-		default:
-			THROW(ERR_NOT_IMPLEMENTED);
-		}
+		// sanity checks
+		CHECK_STATE(STATE_OUTPUT_TOKEN);
+	}
+	output_context_t* subctx = accessSubcontext();
+	{
+		// parse data
+		TRACE_BUFFER(wireDataBuffer, wireDataSize);
+		read_view_t view = make_read_view(wireDataBuffer, wireDataBuffer + wireDataSize);
 
-		handleToken_ui_runStep();
+		const uint8_t numPackedTokens = parse_u1be(&view);
+		VALIDATE(numPackedTokens > 0, ERR_INVALID_DATA);
+		ASSERT(subctx->stateData.currentToken < subctx->stateData.numTokens);
+		VALIDATE(
+		        numPackedTokens <= subctx->stateData.numTokens - subctx->stateData.currentToken,
+		        ERR_INVALID_DATA
+		);
+
+		validatePackedTokens(view, numPackedTokens);
+
+		// the first token is processed right away, the rest is kept
+		parsePackedToken(&view, &subctx->stateData.token);
+
+		const size_t packedTokensSize = view_remainingSize(&view);
+		VALIDATE(packedTokensSize <= SIZEOF(subctx->stateData.packedTokens), ERR_INVALID_DATA);
+		view_parseBuffer(subctx->stateData.packedTokens, &view, packedTokensSize);
+		subctx->stateData.packedTokensSize = packedTokensSize;
+		subctx->stateData.packedTokensOffset = 0;
+		subctx->stateData.numPackedTokens = numPackedTokens - 1;
+	}
+
+	addTokenToTx();
+	selectTokenUIStep();
+
+	if (subctx->ui_step == HANDLE_TOKEN_STEP_RESPOND) {
+		// nothing is shown, so there is no reason to wait for the UI
+		while (subctx->stateData.numPackedTokens > 0) {
+			ASSERT(subctx->stateData.currentToken < subctx->stateData.numTokens);
+			subctx->stateData.currentToken++;
+			tx_output_processNextPackedToken();
+		}
 	}
+
+	handleToken_ui_runStep();
 }
 
 // ========================== DATUM =============================
@@ -968,13 +1158,9 @@ static void handleRefScriptChunkAPDU(const uint8_t* wireDataBuffer, size_t wireD
 
 // ============================== CONFIRM ==============================
 
-static void handleConfirmAPDU_output(const uint8_t* wireDataBuffer MARK_UNUSED, size_t wireDataSize)
+static void handleConfirm_output()
 {
-	{
-		CHECK_STATE(STATE_OUTPUT_CONFIRM);
-
-		VALIDATE(wireDataSize == 0, ERR_INVALID_DATA);
-	}
+	CHECK_STATE(STATE_OUTPUT_CONFIRM);
 
 	output_context_t* subctx = accessSubcontext();
 	security_policy_t policy = policyForSignTxOutputConfirm(
@@ -1004,6 +1190,17 @@ static void handleConfirmAPDU_output(const uint8_t* wireDataBuffer MARK_UNUSED,
 	signTxOutput_handleConfirm_ui_runStep();
 }
 
+static void handleConfirmAPDU_output(const uint8_t* wireDataBuffer MARK_UNUSED, size_t wireDataSize)
+{
+	{
+		CHECK_STATE(STATE_OUTPUT_CONFIRM);
+
+		VALIDATE(wireDataSize == 0, ERR_INVALID_DATA);
+	}
+
+	handleConfirm_output();
+}
+
 static void handleConfirmAPDU_collateralOutput(const uint8_t* wireDataBuffer MARK_UNUSED, size_t wireDataSize)
 {
 	{
@@ -1038,6 +1235,54 @@ static void handleConfirmAPDU_collateralOutput(const uint8_t* wireDataBuffer MAR
 	signTxOutput_handleConfirm_ui_runStep();
 }
 
+// ============================== SIMPLE OUTPUT CHAINING ==============================
+
+// Called by the UI when an item of the output has been processed.
+// A simple output gets a single response after it is finished,
+// so its remaining items are processed right away instead of responding.
+// Their UI machines run on the same subctx->ui_step and may stop at a screen,
+// so the calling UI step must set its machine to the invalid step before
+// the call and return right after it (instead of reaching UI_STEP_END).
+void tx_output_respondAndAdvanceState()
+{
+	output_context_t* subctx = accessSubcontext();
+
+	if (!subctx->isSimpleOutput) {
+		respondSuccessEmptyMsg();
+		tx_output_advanceState();
+		return;
+	}
+
+	tx_output_advanceState();
+
+	switch (subctx->state) {
+
+	case STATE_OUTPUT_DATUM: {
+		ASSERT(subctx->includeDatum);
+
+		// the destination is not needed anymore, the datum hash overwrites it
+		uint8_t datumHash[OUTPUT_DATUM_HASH_LENGTH] = {0};
+		memmove(datumHash, subctx->stateData.simpleOutputDatumHash, SIZEOF(datumHash));
+		subctx->stateData.datumType = DATUM_HASH;
+
+		read_view_t view = make_read_view(datumHash, datumHash + SIZEOF(datumHash));
+		handleDatumHash(&view);
+		break;
+	}
+
+	case STATE_OUTPUT_CONFIRM:
+		handleConfirm_output();
+		break;
+
+	case STATE_OUTPUT_FINISHED:
+		respondSuccessEmptyMsg();
+		break;
+
+	default:
+		ASSERT(false);
+	}
+}
+
 // ============================== main APDU handler ==============================
 
 enum {
@@ -1049,6 +1294,8 @@ enum {
 	APDU_INSTRUCTION_REF_SCRIPT = 0x36,
 	APDU_INSTRUCTION_REF_SCRIPT_CHUNK = 0x37,
 	APDU_INSTRUCTION_CONFIRM = 0x33,
+	APDU_INSTRUCTION_SIMPLE_OUTPUT = 0x38,
+	APDU_INSTRUCTION_PACKED_TOKENS = 0x39,
 };
 
 bool signTxOutput_isValidInstruction(uint8_t p2)
@@ -1057,11 +1304,13 @@ bool signTxOutput_isValidInstruction(uint8_t p2)
 	case APDU_INSTRUCTION_TOP_LEVEL_DATA:
 	case APDU_INSTRUCTION_ASSET_GROUP:
 	case APDU_INSTRUCTION_TOKEN:
+	case APDU_INSTRUCTION_PACKED_TOKENS:
 	case APDU_INSTRUCTION_DATUM:
 	case APDU_INSTRUCTION_DATUM_CHUNK:
 	case APDU_INSTRUCTION_REF_SCRIPT:
 	case APDU_INSTRUCTION_REF_SCRIPT_CHUNK:
 	case APDU_INSTRUCTION_CONFIRM:
+	case APDU_INSTRUCTION_SIMPLE_OUTPUT:
 		return true;
 
 	default:
@@ -1087,6 +1336,10 @@ void signTxOutput_handleAPDU(uint8_t p2, const uint8_t* wireDataBuffer, size_t w
 		handleTokenAPDU(wireDataBuffer, wireDataSize);
 		break;
 
+	case APDU_INSTRUCTION_PACKED_TOKENS:
+		handlePackedTokensAPDU(wireDataBuffer, wireDataSize);
+		break;
+
 	case APDU_INSTRUCTION_DATUM:
 		handleDatumAPDU(wireDataBuffer, wireDataSize);
 		break;
@@ -1107,6 +1360,10 @@ void signTxOutput_handleAPDU(uint8_t p2, const uint8_t* wireDataBuffer, size_t w
 		handleConfirmAPDU_output(wireDataBuffer, wireDataSize);
 		break;
 
+	case APDU_INSTRUCTION_SIMPLE_OUTPUT:
+		handleSimpleOutputAPDU(wireDataBuffer, wireDataSize);
+		break;
+
 	default:
 		// this is not supposed to be called with invalid p2
 		ASSERT(false);
@@ -1119,6 +1376,7 @@ bool signTxCollateralOutput_isValidInstruction(uint8_t p2)
 	case APDU_INSTRUCTION_TOP_LEVEL_DATA:
 	case APDU_INSTRUCTION_ASSET_GROUP:
 	case APDU_INSTRUCTION_TOKEN:
+	case APDU_INSTRUCTION_PACKED_TOKENS:
 	case APDU_INSTRUCTION_DATUM:
 	case APDU_INSTRUCTION_DATUM_CHUNK:
 	case APDU_INSTRUCTION_REF_SCRIPT:
@@ -1149,6 +1407,10 @@ void signTxCollateralOutput_handleAPDU(uint8_t p2, const uint8_t* wireDataBuffer
 		handleTokenAPDU(wireDataBuffer, wireDataSize);
 		break;
 
+	case APDU_INSTRUCTION_PACKED_TOKENS:
+		handlePackedTokensAPDU(wireDataBuffer, wireDataSize);
+		break;
+
 	case APDU_INSTRUCTION_CONFIRM:
 		handleConfirmAPDU_collateralOutput(wireDataBuffer, wireDataSize);
 		break;
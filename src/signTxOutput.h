@@ -45,6 +45,8 @@ typedef struct {
 	bool includeDatum;
 	bool datumHashReceived; // is this needed?
 	bool includeRefScript;
+	// all items of the output came in a single APDU
+	bool isSimpleOutput;
 
 	// this affects whether amounts and tokens are shown
 	security_policy_t outputSecurityPolicy;
@@ -57,6 +59,9 @@ typedef struct {
 
 			uint64_t adaAmount;
 			security_policy_t adaAmountSecurityPolicy;
+
+			// kept until the top level data are processed
+			uint8_t simpleOutputDatumHash[OUTPUT_DATUM_HASH_LENGTH];
 		};
 		struct {
 			// data for processing a multiasset map
@@ -65,6 +70,12 @@ typedef struct {
 			uint16_t currentAssetGroup;
 			uint16_t currentToken;
 			uint16_t numTokens;
+
+			// the records of a packed APDU following the token being processed
+			uint8_t numPackedTokens;
+			size_t packedTokensSize;
+			size_t packedTokensOffset;
+			uint8_t packedTokens[PACKED_TOKENS_BUFFER_SIZE];
 		};
 		struct {
 			// data for processing datum
@@ -102,4 +113,6 @@ bool signTxCollateralOutput_isValidInstruction(uint8_t p2);
 void signTxCollateralOutput_handleAPDU(uint8_t p2, const uint8_t* wireDataBuffer, size_t wireDataSize);
 
 void tx_output_advanceState();
+void tx_output_respondAndAdvanceState();
+void tx_output_processNextPackedToken();
 #endif // H_CARDANO_APP_SIGN_TX_OUTPUT
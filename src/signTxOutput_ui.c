@@ -96,8 +96,10 @@ void signTx_handleOutput_address_bytes_ui_runStep()
 		#endif // HAVE_BAGL
 	}
 	UI_STEP(HANDLE_OUTPUT_ADDRESS_BYTES_STEP_RESPOND) {
-		respondSuccessEmptyMsg();
-		tx_output_advanceState();
+		// leaves this UI machine before chaining, see tx_output_respondAndAdvanceState
+		subctx->ui_step = HANDLE_OUTPUT_ADDRESS_BYTES_STEP_INVALID;
+		tx_output_respondAndAdvanceState();
+		return;
 	}
 	UI_STEP_END(HANDLE_OUTPUT_ADDRESS_BYTES_STEP_INVALID);
 }
@@ -147,7 +149,11 @@ void signTx_handleOutput_addressParams_ui_runStep()
 	}
 	UI_STEP(HANDLE_OUTPUT_ADDRESS_PARAMS_STEP_DISPLAY_ADDRESS) {
 		uint8_t addressBuffer[MAX_ADDRESS_SIZE] = {0};
-		size_t addressSize = deriveAddress(&subctx->stateData.destination.params, addressBuffer, SIZEOF(addressBuffer));
+		size_t addressSize = deriveAddressWithKeyHashFn(
+		                             &subctx->stateData.destination.params,
+		                             tx_pathToKeyHash,
+		                             addressBuffer, SIZEOF(addressBuffer)
+		                     );
 		ASSERT(addressSize > 0);
 		ASSERT(addressSize <= MAX_ADDRESS_SIZE);
 
@@ -182,8 +188,10 @@ void signTx_handleOutput_addressParams_ui_runStep()
 		}
 	}
 	UI_STEP(HANDLE_OUTPUT_ADDRESS_PARAMS_STEP_RESPOND) {
-		respondSuccessEmptyMsg();
-		tx_output_advanceState();
+		// leaves this UI machine before chaining, see tx_output_respondAndAdvanceState
+		subctx->ui_step = HANDLE_OUTPUT_ADDRESS_PARAMS_STEP_INVALID;
+		tx_output_respondAndAdvanceState();
+		return;
 	}
 	UI_STEP_END(HANDLE_OUTPUT_ADDRESS_PARAMS_STEP_INVALID);
 }
@@ -299,9 +307,18 @@ void handleToken_ui_runStep()
 		#endif // HAVE_BAGL
 	}
 	UI_STEP(HANDLE_TOKEN_STEP_RESPOND) {
+		ASSERT(subctx->stateData.currentToken < subctx->stateData.numTokens);
+
+		if (subctx->stateData.numPackedTokens > 0) {
+			// the APDU is answered once all its tokens have been shown
+			subctx->stateData.currentToken++;
+			tx_output_processNextPackedToken();
+			ASSERT(subctx->ui_step == HANDLE_TOKEN_STEP_DISPLAY_NAME);
+			UI_STEP_JUMP(HANDLE_TOKEN_STEP_DISPLAY_NAME);
+		}
+
 		respondSuccessEmptyMsg();
 
-		ASSERT(subctx->stateData.currentToken < subctx->stateData.numTokens);
 		subctx->stateData.currentToken++;
 
 		if (subctx->stateData.currentToken == subctx->stateData.numTokens) {
@@ -337,8 +354,10 @@ void signTxOutput_handleDatumHash_ui_runStep()
 		#endif // HAVE_BAGL
 	}
 	UI_STEP(HANDLE_DATUM_HASH_STEP_RESPOND) {
-		respondSuccessEmptyMsg();
-		tx_output_advanceState();
+		// leaves this UI machine before chaining, see tx_output_respondAndAdvanceState
+		subctx->ui_step = HANDLE_DATUM_HASH_STEP_INVALID;
+		tx_output_respondAndAdvanceState();
+		return;
 	}
 	UI_STEP_END(HANDLE_DATUM_HASH_STEP_INVALID);
 }
@@ -454,8 +473,10 @@ void signTxOutput_handleConfirm_ui_runStep()
 		#endif // HAVE_BAGL
 	}
 	UI_STEP(HANDLE_CONFIRM_STEP_RESPOND) {
-		respondSuccessEmptyMsg();
-		tx_output_advanceState();
+		// leaves this UI machine before chaining, see tx_output_respondAndAdvanceState
+		subctx->ui_step = HANDLE_CONFIRM_STEP_INVALID;
+		tx_output_respondAndAdvanceState();
+		return;
 	}
 	UI_STEP_END(HANDLE_CONFIRM_STEP_INVALID);
 }
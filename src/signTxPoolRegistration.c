@@ -141,7 +141,7 @@ static void _toPoolKeyHash(const pool_id_t* poolId, uint8_t* poolKeyHash)
 		break;
 	}
 	case KEY_REFERENCE_PATH: {
-		bip44_pathToKeyHash(&poolId->path, poolKeyHash, POOL_KEY_HASH_LENGTH);
+		tx_pathToKeyHash(&poolId->path, poolKeyHash, POOL_KEY_HASH_LENGTH);
 		break;
 	}
 	default:
@@ -457,7 +457,7 @@ static void _addOwnerToTxHash()
 	switch (owner->keyReferenceType) {
 
 	case KEY_REFERENCE_PATH:
-		bip44_pathToKeyHash(&owner->path, ownerKeyHash, SIZEOF(ownerKeyHash));
+		tx_pathToKeyHash(&owner->path, ownerKeyHash, SIZEOF(ownerKeyHash));
 		break;
 
 	case KEY_REFERENCE_HASH:
@@ -139,7 +139,7 @@ static void _toPoolKeyHash(const pool_id_t* poolId, uint8_t* poolKeyHash)
 		break;
 	}
 	case KEY_REFERENCE_PATH: {
-		bip44_pathToKeyHash(&poolId->path, poolKeyHash, POOL_KEY_HASH_LENGTH);
+		tx_pathToKeyHash(&poolId->path, poolKeyHash, POOL_KEY_HASH_LENGTH);
 		break;
 	}
 	default:
@@ -0,0 +1,112 @@
+#ifdef APP_FEATURE_SIGN_TX_SESSION
+
+#include <cx.h>
+
+#include "signTxSession.h"
+#include "handlers.h"
+#include "signTx.h"
+#include "state.h"
+
+static ins_sign_tx_context_t* ctx = &(instructionState.signTxContext);
+
+// A confirmed tx whose witnesses may be requested later by a new SIGN_TX
+// instruction, without streaming and confirming the tx again.
+// Only public data are stored. The session is closed when any other
+// instruction is started or when it times out.
+static struct {
+	bool isOpen;
+	uint8_t id[SIGN_TX_SESSION_ID_LENGTH];
+	uint16_t ticksLeft;
+
+	// everything the witness stage needs from the tx
+	sign_tx_signingmode_t txSigningMode;
+	single_account_data_t singleAccountData;
+	bool includeMint;
+	bool poolOwnerByPath;
+	bip44_path_t poolOwnerPath;
+	uint8_t txHash[TX_HASH_LENGTH];
+} session;
+
+static void _storeTx()
+{
+	session.txSigningMode = ctx->commonTxData.txSigningMode;
+	session.singleAccountData = ctx->commonTxData.singleAccountData;
+	session.includeMint = ctx->includeMint;
+	session.poolOwnerByPath = ctx->poolOwnerByPath;
+	session.poolOwnerPath = ctx->poolOwnerPath;
+	STATIC_ASSERT(SIZEOF(session.txHash) == SIZEOF(ctx->txHash), "wrong tx hash size");
+	memmove(session.txHash, ctx->txHash, SIZEOF(session.txHash));
+}
+
+void signTxSession_open(uint8_t* id, size_t idSize)
+{
+	ASSERT(idSize == SIGN_TX_SESSION_ID_LENGTH);
+
+	signTxSession_close();
+
+	cx_rng_no_throw(session.id, SIZEOF(session.id));
+	_storeTx();
+	session.ticksLeft = SIGN_TX_SESSION_TIMEOUT_TICKS;
+	session.isOpen = true;
+
+	memmove(id, session.id, idSize);
+}
+
+void signTxSession_update()
+{
+	if (session.isOpen) {
+		_storeTx();
+	}
+}
+
+bool signTxSession_resume(const uint8_t* id, size_t idSize)
+{
+	ASSERT(idSize == SIGN_TX_SESSION_ID_LENGTH);
+
+	// compared in constant time
+	uint8_t difference = 0;
+	for (size_t i = 0; i < SIGN_TX_SESSION_ID_LENGTH; i++) {
+		difference |= session.id[i] ^ id[i];
+	}
+
+	if (!session.isOpen || difference != 0) {
+		// a single attempt per session, the id cannot be guessed by retrying
+		signTxSession_close();
+		return false;
+	}
+
+	ctx->commonTxData.txSigningMode = session.txSigningMode;
+	ctx->commonTxData.singleAccountData = session.singleAccountData;
+	ctx->includeMint = session.includeMint;
+	ctx->poolOwnerByPath = session.poolOwnerByPath;
+	ctx->poolOwnerPath = session.poolOwnerPath;
+	memmove(ctx->txHash, session.txHash, SIZEOF(ctx->txHash));
+	return true;
+}
+
+void signTxSession_close()
+{
+	explicit_bzero(&session, SIZEOF(session));
+}
+
+void signTxSession_startInstruction(uint8_t ins, uint8_t p1)
+{
+	if (ins != INS_SIGN_TX || p1 != SIGN_TX_P1_RESUME_SESSION) {
+		signTxSession_close();
+	}
+}
+
+void signTxSession_tick()
+{
+	// called from io_event, must not throw
+	if (!session.isOpen) {
+		return;
+	}
+	if (session.ticksLeft > 1) {
+		session.ticksLeft--;
+	} else {
+		signTxSession_close();
+	}
+}
+
+#endif // APP_FEATURE_SIGN_TX_SESSION
@@ -0,0 +1,42 @@
+#ifndef H_CARDANO_APP_SIGN_TX_SESSION
+#define H_CARDANO_APP_SIGN_TX_SESSION
+
+#include "common.h"
+
+#ifdef APP_FEATURE_SIGN_TX_SESSION
+
+// SIGN_TX with this P1 resumes a session, see signTx_handleResumeSessionAPDU
+#define SIGN_TX_P1_RESUME_SESSION 0x17
+
+#define SIGN_TX_SESSION_ID_LENGTH 16
+
+// ticker events come every 100 ms, the session expires after 5 minutes
+#define SIGN_TX_SESSION_TIMEOUT_TICKS (5 * 60 * 10)
+
+// replaces the open session (if any) by a new one for the tx in the SIGN_TX context,
+// the tx must be confirmed (its hash is stored)
+void signTxSession_open(uint8_t* id, size_t idSize);
+
+// stores the SIGN_TX context again if a session is open
+// (witnesses may update the single account data)
+void signTxSession_update();
+
+// restores the tx of the open session into the SIGN_TX context if the id matches,
+// otherwise closes the session (if any) and returns false
+bool signTxSession_resume(const uint8_t* id, size_t idSize);
+
+void signTxSession_close();
+
+// closes the session unless the new instruction resumes it
+void signTxSession_startInstruction(uint8_t ins, uint8_t p1);
+
+// counts down the session timeout, called on ticker events
+void signTxSession_tick();
+
+#ifdef DEVEL
+void run_signTxSession_test();
+#endif // DEVEL
+
+#endif // APP_FEATURE_SIGN_TX_SESSION
+
+#endif // H_CARDANO_APP_SIGN_TX_SESSION
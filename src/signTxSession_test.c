@@ -0,0 +1,177 @@
+#ifdef DEVEL
+
+#include "signTxSession.h"
+#include "handlers.h"
+#include "signTx.h"
+#include "state.h"
+#include "testUtils.h"
+
+#ifdef APP_FEATURE_SIGN_TX_SESSION
+
+#define HD HARDENED_BIP32
+
+static ins_sign_tx_context_t* ctx = &(instructionState.signTxContext);
+
+// a confirmed tx in the SIGN_TX context
+static void setConfirmedTx()
+{
+	explicit_bzero(ctx, SIZEOF(*ctx));
+
+	ctx->commonTxData.txSigningMode = SIGN_TX_SIGNINGMODE_POOL_REGISTRATION_OWNER;
+	ctx->includeMint = true;
+	ctx->poolOwnerByPath = true;
+	const uint32_t path[] = {HD + 1852, HD + 1815, HD + 0, 2, 0};
+	ctx->poolOwnerPath.length = ARRAY_LEN(path);
+	memmove(ctx->poolOwnerPath.path, path, SIZEOF(path));
+	memset(ctx->txHash, 0xab, SIZEOF(ctx->txHash));
+}
+
+static void expectRestoredTx()
+{
+	EXPECT_EQ(ctx->commonTxData.txSigningMode, SIGN_TX_SIGNINGMODE_POOL_REGISTRATION_OWNER);
+	EXPECT_EQ(ctx->includeMint, true);
+	EXPECT_EQ(ctx->poolOwnerByPath, true);
+	EXPECT_EQ(ctx->poolOwnerPath.length, 5);
+	EXPECT_EQ(ctx->poolOwnerPath.path[0], HD + 1852);
+
+	uint8_t txHash[TX_HASH_LENGTH];
+	memset(txHash, 0xab, SIZEOF(txHash));
+	EXPECT_EQ_BYTES(ctx->txHash, txHash, SIZEOF(txHash));
+}
+
+static void testResume()
+{
+	PRINTF("testResume\n");
+
+	setConfirmedTx();
+	uint8_t id[SIGN_TX_SESSION_ID_LENGTH] = {0};
+	signTxSession_open(id, SIZEOF(id));
+
+	explicit_bzero(ctx, SIZEOF(*ctx));
+	signTxSession_startInstruction(INS_SIGN_TX, SIGN_TX_P1_RESUME_SESSION);
+	EXPECT_EQ(signTxSession_resume(id, SIZEOF(id)), true);
+	expectRestoredTx();
+
+	// the session stays open for further resumes
+	explicit_bzero(ctx, SIZEOF(*ctx));
+	EXPECT_EQ(signTxSession_resume(id, SIZEOF(id)), true);
+	expectRestoredTx();
+
+	signTxSession_close();
+	EXPECT_EQ(signTxSession_resume(id, SIZEOF(id)), false);
+}
+
+static void testWrongId()
+{
+	PRINTF("testWrongId\n");
+
+	setConfirmedTx();
+	uint8_t id[SIGN_TX_SESSION_ID_LENGTH] = {0};
+	signTxSession_open(id, SIZEOF(id));
+
+	uint8_t wrongId[SIGN_TX_SESSION_ID_LENGTH] = {0};
+	memmove(wrongId, id, SIZEOF(id));
+	wrongId[SIZEOF(wrongId) - 1] ^= 0x01;
+	EXPECT_EQ(signTxSession_resume(wrongId, SIZEOF(wrongId)), false);
+
+	// a failed attempt closes the session
+	EXPECT_EQ(signTxSession_resume(id, SIZEOF(id)), false);
+
+	// a new session gets a new id
+	uint8_t newId[SIGN_TX_SESSION_ID_LENGTH] = {0};
+	signTxSession_open(newId, SIZEOF(newId));
+	signTxSession_open(id, SIZEOF(id));
+	EXPECT_EQ(memcmp(id, newId, SIZEOF(id)) != 0, true);
+	EXPECT_EQ(signTxSession_resume(newId, SIZEOF(newId)), false);
+	signTxSession_close();
+}
+
+static void testOtherInstructions()
+{
+	PRINTF("testOtherInstructions\n");
+
+	const struct {
+		uint8_t ins;
+		uint8_t p1;
+		bool keepsSession;
+	} testVectors[] = {
+		{INS_SIGN_TX, SIGN_TX_P1_RESUME_SESSION, true},
+		{INS_SIGN_TX, 0x01, false}, // a new tx
+		{INS_SIGN_TX, 0x0f, false},
+		{0x10, SIGN_TX_P1_RESUME_SESSION, false},
+		{0x00, 0x00, false},
+	};
+
+	ITERATE(it, testVectors) {
+		setConfirmedTx();
+		uint8_t id[SIGN_TX_SESSION_ID_LENGTH] = {0};
+		signTxSession_open(id, SIZEOF(id));
+
+		signTxSession_startInstruction(it->ins, it->p1);
+		EXPECT_EQ(signTxSession_resume(id, SIZEOF(id)), it->keepsSession);
+	}
+	signTxSession_close();
+}
+
+static void testTimeout()
+{
+	PRINTF("testTimeout\n");
+
+	setConfirmedTx();
+	uint8_t id[SIGN_TX_SESSION_ID_LENGTH] = {0};
+	signTxSession_open(id, SIZEOF(id));
+
+	for (size_t i = 0; i + 1 < SIGN_TX_SESSION_TIMEOUT_TICKS; i++) {
+		signTxSession_tick();
+	}
+	EXPECT_EQ(signTxSession_resume(id, SIZEOF(id)), true);
+
+	signTxSession_tick();
+	EXPECT_EQ(signTxSession_resume(id, SIZEOF(id)), false);
+
+	// ticks without a session do nothing
+	signTxSession_tick();
+}
+
+static void testUpdate()
+{
+	PRINTF("testUpdate\n");
+
+	setConfirmedTx();
+	uint8_t id[SIGN_TX_SESSION_ID_LENGTH] = {0};
+	signTxSession_open(id, SIZEOF(id));
+
+	// a witness stored the single account
+	ctx->commonTxData.singleAccountData.isStored = true;
+	ctx->commonTxData.singleAccountData.accountNumber = HD + 3;
+	signTxSession_update();
+
+	explicit_bzero(ctx, SIZEOF(*ctx));
+	EXPECT_EQ(signTxSession_resume(id, SIZEOF(id)), true);
+	expectRestoredTx();
+	EXPECT_EQ(ctx->commonTxData.singleAccountData.isStored, true);
+	EXPECT_EQ(ctx->commonTxData.singleAccountData.accountNumber, HD + 3);
+
+	// no session, nothing to update
+	signTxSession_close();
+	signTxSession_update();
+	EXPECT_EQ(signTxSession_resume(id, SIZEOF(id)), false);
+}
+
+#undef HD
+
+void run_signTxSession_test()
+{
+	PRINTF("Running sign tx session tests\n");
+	testResume();
+	testWrongId();
+	testOtherInstructions();
+	testTimeout();
+	testUpdate();
+
+	explicit_bzero(ctx, SIZEOF(*ctx));
+}
+
+#endif // APP_FEATURE_SIGN_TX_SESSION
+
+#endif // DEVEL
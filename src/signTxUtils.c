@@ -55,6 +55,15 @@ bool violatesSingleAccountOrStoreIt(const bip44_path_t* path)
 	return false;
 }
 
+void tx_pathToKeyHash(const bip44_path_t* path, uint8_t* hash, size_t hashSize)
+{
+	#ifdef APP_FEATURE_KEY_HASH_CACHE
+	keyHashCache_pathToKeyHash(&instructionState.signTxContext.keyHashCache, path, hash, hashSize);
+	#else
+	bip44_pathToKeyHash(path, hash, hashSize);
+	#endif // APP_FEATURE_KEY_HASH_CACHE
+}
+
 void view_parseDestination(read_view_t* view, tx_output_destination_storage_t* destination)
 {
 	destination->type = parse_u1be(view);
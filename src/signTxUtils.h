@@ -16,6 +16,14 @@ void respondSuccessEmptyMsg();
  */
 bool violatesSingleAccountOrStoreIt(const bip44_path_t* path);
 
+/**
+ * Computes the key hash of a path referenced by the tx being signed.
+ *
+ * The same paths (typically the staking key) tend to appear several times
+ * in one tx, so the hashes are cached for the rest of the tx if possible.
+ */
+void tx_pathToKeyHash(const bip44_path_t* path, uint8_t* hash, size_t hashSize);
+
 void view_parseDestination(read_view_t* view, tx_output_destination_storage_t* destination);
 
 #endif // H_CARDANO_APP_SIGN_TX_UTILS
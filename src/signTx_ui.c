@@ -15,6 +15,7 @@
 #include "bufView.h"
 #include "securityPolicy.h"
 #include "signTx_ui.h"
+#include "signTxSession.h"
 
 #ifdef HAVE_BAGL
 #include "uiScreens_bagl.h"
@@ -262,26 +263,75 @@ void signTx_handleAuxDataCVoteRegistration_ui_runStep()
 
 // ============================== INPUTS ==============================
 
+static void _constructInputLabel()
+{
+	sign_tx_transaction_inputs_t* inputs = &BODY_CTX->stageData.inputs;
+
+	// inputs of all kinds share the UI, the stage tells them apart
+	const char* prefix = NULL;
+	uint16_t index = 0;
+	switch (ctx->stage) {
+	case SIGN_STAGE_BODY_INPUTS:
+		prefix = "Input";
+		index = BODY_CTX->currentInput;
+		break;
+
+	case SIGN_STAGE_BODY_COLLATERAL_INPUTS:
+		prefix = "Collat. input";
+		index = BODY_CTX->currentCollateral;
+		break;
+
+	case SIGN_STAGE_BODY_REFERENCE_INPUTS:
+		prefix = "Refer. input";
+		index = BODY_CTX->currentReferenceInput;
+		break;
+
+	default:
+		ASSERT(false);
+	}
+	// the counters are only advanced after the whole batch is processed
+	index += inputs->currentDisplayedInput;
+
+	char* label = inputs->label;
+	const size_t labelSize = SIZEOF(inputs->label);
+	explicit_bzero(label, labelSize);
+	// indexed from 0 as agreed with IOG on Slack
+	snprintf(label, labelSize, "%s #%u", prefix, index);
+	// make sure all the information is displayed to the user
+	ASSERT(strlen(label) + 1 < labelSize);
+}
+
 void signTx_handleInput_ui_runStep()
 {
 	TRACE("UI step %d", ctx->ui_step);
 	ui_callback_fn_t* this_fn = signTx_handleInput_ui_runStep;
+	sign_tx_transaction_inputs_t* inputs = &BODY_CTX->stageData.inputs;
 
 	UI_STEP_BEGIN(ctx->ui_step, this_fn);
 
 	UI_STEP(HANDLE_INPUT_STEP_DISPLAY) {
+		ASSERT(inputs->currentDisplayedInput < inputs->numInputs);
+		_constructInputLabel();
+		const tx_input_t* inputData = &inputs->inputs[inputs->currentDisplayedInput];
+		inputs->currentDisplayedInput++;
+
 		#ifdef HAVE_BAGL
-		ui_displayInputScreen(&BODY_CTX->stageData.input, this_fn);
+		ui_displayInputScreen(inputs->label, inputData, this_fn);
 		#elif defined(HAVE_NBGL)
 		// index 32 bit (10) + separator (" / ") + utxo hash hex format + \0
 		// + 1 byte to detect if everything has been written
 		char inputStr[10 + 3 + TX_HASH_LENGTH * 2 + 1 + 1] = {0};
 
-		ui_getInputScreen(inputStr, SIZEOF(inputStr), &BODY_CTX->stageData.input);
-		fill_and_display_if_required(BODY_CTX->stageData.input.label, inputStr, this_fn, respond_with_user_reject);
+		ui_getInputScreen(inputStr, SIZEOF(inputStr), inputData);
+		fill_and_display_if_required(inputs->label, inputStr, this_fn, respond_with_user_reject);
 		#endif // HAVE_BAGL
 	}
-
+	UI_STEP(HANDLE_INPUT_STEP_DISPLAY_NEXT) {
+		if (inputs->currentDisplayedInput < inputs->numInputs) {
+			UI_STEP_JUMP(HANDLE_INPUT_STEP_DISPLAY);
+		}
+		UI_STEP_JUMP(HANDLE_INPUT_STEP_RESPOND);
+	}
 	UI_STEP(HANDLE_INPUT_STEP_RESPOND) {
 		respondSuccessEmptyMsg();
 
@@ -1137,24 +1187,27 @@ void signTx_handleWithdrawal_ui_runStep()
 	TRACE("UI step %d", ctx->ui_step);
 	TRACE_STACK_USAGE();
 	ui_callback_fn_t* this_fn = signTx_handleWithdrawal_ui_runStep;
+	sign_tx_withdrawals_t* withdrawals = &BODY_CTX->stageData.withdrawals;
+	ASSERT(withdrawals->currentDisplayedWithdrawal < withdrawals->numWithdrawals);
+	const sign_tx_withdrawal_data_t* withdrawal = &withdrawals->withdrawals[withdrawals->currentDisplayedWithdrawal];
 
 	UI_STEP_BEGIN(ctx->ui_step, this_fn);
 
 	UI_STEP(HANDLE_WITHDRAWAL_STEP_DISPLAY_AMOUNT) {
 		#ifdef HAVE_BAGL
-		ui_displayAdaAmountScreen("Withdrawing rewards", BODY_CTX->stageData.withdrawal.amount, this_fn);
+		ui_displayAdaAmountScreen("Withdrawing rewards", withdrawal->amount, this_fn);
 		#elif defined(HAVE_NBGL)
 		char adaAmountStr[50] = {0};
-		ui_getAdaAmountScreen(adaAmountStr, SIZEOF(adaAmountStr), BODY_CTX->stageData.withdrawal.amount);
+		ui_getAdaAmountScreen(adaAmountStr, SIZEOF(adaAmountStr), withdrawal->amount);
 		fill_and_display_if_required("Withdrawing rewards", adaAmountStr, this_fn, respond_with_user_reject);
 		#endif // HAVE_BAGL
 	}
 	UI_STEP(HANDLE_WITHDRAWAL_STEP_DISPLAY_PATH) {
 		reward_account_t rewardAccount;
-		switch (BODY_CTX->stageData.withdrawal.stakeCredential.type) {
+		switch (withdrawal->stakeCredential.type) {
 		case EXT_CREDENTIAL_KEY_PATH: {
 			rewardAccount.keyReferenceType = KEY_REFERENCE_PATH;
-			rewardAccount.path = BODY_CTX->stageData.withdrawal.stakeCredential.keyPath;
+			rewardAccount.path = withdrawal->stakeCredential.keyPath;
 			break;
 		}
 		case EXT_CREDENTIAL_KEY_HASH: {
@@ -1162,8 +1215,8 @@ void signTx_handleWithdrawal_ui_runStep()
 			constructRewardAddressFromHash(
 			        ctx->commonTxData.networkId,
 			        REWARD_HASH_SOURCE_KEY,
-			        BODY_CTX->stageData.withdrawal.stakeCredential.keyHash,
-			        SIZEOF(BODY_CTX->stageData.withdrawal.stakeCredential.keyHash),
+			        withdrawal->stakeCredential.keyHash,
+			        SIZEOF(withdrawal->stakeCredential.keyHash),
 			        rewardAccount.hashBuffer,
 			        SIZEOF(rewardAccount.hashBuffer)
 			);
@@ -1174,8 +1227,8 @@ void signTx_handleWithdrawal_ui_runStep()
 			constructRewardAddressFromHash(
 			        ctx->commonTxData.networkId,
 			        REWARD_HASH_SOURCE_SCRIPT,
-			        BODY_CTX->stageData.withdrawal.stakeCredential.scriptHash,
-			        SIZEOF(BODY_CTX->stageData.withdrawal.stakeCredential.scriptHash),
+			        withdrawal->stakeCredential.scriptHash,
+			        SIZEOF(withdrawal->stakeCredential.scriptHash),
 			        rewardAccount.hashBuffer,
 			        SIZEOF(rewardAccount.hashBuffer)
 			);
@@ -1194,12 +1247,19 @@ void signTx_handleWithdrawal_ui_runStep()
 		fill_and_display_if_required(firstLine, secondLine, this_fn, respond_with_user_reject);
 		#endif // HAVE_BAGL
 	}
+	UI_STEP(HANDLE_WITHDRAWAL_STEP_DISPLAY_NEXT) {
+		if (withdrawals->currentDisplayedWithdrawal + 1 < withdrawals->numWithdrawals) {
+			withdrawals->currentDisplayedWithdrawal++;
+			UI_STEP_JUMP(HANDLE_WITHDRAWAL_STEP_DISPLAY_AMOUNT);
+		}
+		UI_STEP_JUMP(HANDLE_WITHDRAWAL_STEP_RESPOND);
+	}
 	UI_STEP(HANDLE_WITHDRAWAL_STEP_RESPOND) {
 		respondSuccessEmptyMsg();
 
-		// Advance stage to the next withdrawal
-		ASSERT(BODY_CTX->currentWithdrawal < ctx->numWithdrawals);
-		BODY_CTX->currentWithdrawal++;
+		// Advance stage past the withdrawals received in the current APDU
+		ASSERT(BODY_CTX->currentWithdrawal + withdrawals->numWithdrawals <= ctx->numWithdrawals);
+		BODY_CTX->currentWithdrawal += withdrawals->numWithdrawals;
 
 		if (BODY_CTX->currentWithdrawal == ctx->numWithdrawals) {
 			tx_advanceStage();
@@ -1274,17 +1334,23 @@ void signTx_handleRequiredSigner_ui_runStep()
 {
 	TRACE("UI step %d", ctx->ui_step);
 	ui_callback_fn_t* this_fn = signTx_handleRequiredSigner_ui_runStep;
+	sign_tx_required_signers_t* requiredSigners = &BODY_CTX->stageData.requiredSigners;
 
 	UI_STEP_BEGIN(ctx->ui_step, this_fn);
 
 	UI_STEP(HANDLE_REQUIRED_SIGNERS_STEP_DISPLAY) {
-		switch (BODY_CTX->stageData.requiredSigner.type) {
+		ASSERT(requiredSigners->currentDisplayedRequiredSigner < requiredSigners->numRequiredSigners);
+		const sign_tx_required_signer_t* requiredSigner =
+		        &requiredSigners->requiredSigners[requiredSigners->currentDisplayedRequiredSigner];
+		requiredSigners->currentDisplayedRequiredSigner++;
+
+		switch (requiredSigner->type) {
 		case REQUIRED_SIGNER_WITH_PATH: {
 			#ifdef HAVE_BAGL
-			ui_displayPathScreen("Required signer", &BODY_CTX->stageData.requiredSigner.keyPath, this_fn);
+			ui_displayPathScreen("Required signer", &requiredSigner->keyPath, this_fn);
 			#elif defined(HAVE_NBGL)
 			char pathStr[BIP44_PATH_STRING_SIZE_MAX + 1] = {0};
-			ui_getPathScreen(pathStr, SIZEOF(pathStr), &BODY_CTX->stageData.requiredSigner.keyPath);
+			ui_getPathScreen(pathStr, SIZEOF(pathStr), &requiredSigner->keyPath);
 			fill_and_display_if_required("Required signer", pathStr, this_fn, respond_with_user_reject);
 			#endif // HAVE_BAGL
 			break;
@@ -1294,13 +1360,13 @@ void signTx_handleRequiredSigner_ui_runStep()
 			ui_displayBech32Screen(
 			        "Required signer",
 			        "req_signer_vkh",
-			        BODY_CTX->stageData.requiredSigner.keyHash,
-			        SIZEOF(BODY_CTX->stageData.requiredSigner.keyHash),
+			        requiredSigner->keyHash,
+			        SIZEOF(requiredSigner->keyHash),
 			        this_fn
 			);
 			#elif defined(HAVE_NBGL)
 			char encodedStr[BECH32_STRING_SIZE_MAX] = {0};
-			ui_getBech32Screen(encodedStr, SIZEOF(encodedStr), "req_signer_vkh", BODY_CTX->stageData.requiredSigner.keyHash, SIZEOF(BODY_CTX->stageData.requiredSigner.keyHash));
+			ui_getBech32Screen(encodedStr, SIZEOF(encodedStr), "req_signer_vkh", requiredSigner->keyHash, SIZEOF(requiredSigner->keyHash));
 			fill_and_display_if_required("Required signer", encodedStr, this_fn, respond_with_user_reject);
 			#endif // HAVE_BAGL
 			break;
@@ -1311,13 +1377,18 @@ void signTx_handleRequiredSigner_ui_runStep()
 			break;
 		}
 	}
-
+	UI_STEP(HANDLE_REQUIRED_SIGNERS_STEP_DISPLAY_NEXT) {
+		if (requiredSigners->currentDisplayedRequiredSigner < requiredSigners->numRequiredSigners) {
+			UI_STEP_JUMP(HANDLE_REQUIRED_SIGNERS_STEP_DISPLAY);
+		}
+		UI_STEP_JUMP(HANDLE_REQUIRED_SIGNERS_STEP_RESPOND);
+	}
 	UI_STEP(HANDLE_REQUIRED_SIGNERS_STEP_RESPOND) {
 		respondSuccessEmptyMsg();
 
-		// Advance stage to the next required signer
-		ASSERT(BODY_CTX->currentRequiredSigner < ctx->numRequiredSigners);
-		BODY_CTX->currentRequiredSigner++;
+		// Advance stage past the required signers received in the current APDU
+		ASSERT(BODY_CTX->currentRequiredSigner + requiredSigners->numRequiredSigners <= ctx->numRequiredSigners);
+		BODY_CTX->currentRequiredSigner += requiredSigners->numRequiredSigners;
 
 		if (BODY_CTX->currentRequiredSigner == ctx->numRequiredSigners) {
 			tx_advanceStage();
@@ -1612,7 +1683,19 @@ void signTx_handleConfirm_ui_runStep()
 		#endif // HAVE_BAGL
 	}
 	UI_STEP(HANDLE_CONFIRM_STEP_RESPOND) {
+		#ifdef APP_FEATURE_SIGN_TX_SESSION
+		if (ctx->openSession) {
+			// the tx hash followed by the session id
+			uint8_t response[TX_HASH_LENGTH + SIGN_TX_SESSION_ID_LENGTH] = {0};
+			memmove(response, ctx->txHash, TX_HASH_LENGTH);
+			signTxSession_open(response + TX_HASH_LENGTH, SIGN_TX_SESSION_ID_LENGTH);
+			io_send_buf(SUCCESS, response, SIZEOF(response));
+		} else {
+			io_send_buf(SUCCESS, ctx->txHash, SIZEOF(ctx->txHash));
+		}
+		#else
 		io_send_buf(SUCCESS, ctx->txHash, SIZEOF(ctx->txHash));
+		#endif // APP_FEATURE_SIGN_TX_SESSION
 		#ifdef HAVE_BAGL
 		ui_displayBusy(); // displays dots, called only after I/O to avoid freezing
 		#endif // HAVE_BAGL
@@ -1624,10 +1707,15 @@ void signTx_handleConfirm_ui_runStep()
 
 // ============================== WITNESS ==============================
 
-static void _wipeWitnessSignature()
+static void _rejectWitnesses()
 {
-	// safer not to keep the signature in memory
-	explicit_bzero(WITNESS_CTX->stageData.witness.signature, SIZEOF(WITNESS_CTX->stageData.witness.signature));
+	#ifdef APP_FEATURE_SIGN_TX_SESSION
+	// a rejected witness ends the tx, it cannot be resumed
+	signTxSession_close();
+	#endif // APP_FEATURE_SIGN_TX_SESSION
+	// the signatures and the witness cache are wiped with the whole state
+	// by ui_idle; NBGL calls it before this callback, so the context
+	// must not be accessed here
 	respond_with_user_reject();
 }
 
@@ -1652,36 +1740,62 @@ void signTx_handleWitness_ui_runStep()
 		#endif // HAVE_BAGL
 	}
 	UI_STEP(HANDLE_WITNESS_STEP_DISPLAY) {
+		// all paths in the batch are shown, one screen each, before a single confirmation
+		ASSERT(WITNESS_CTX->stageData.currentDisplayedWitness < WITNESS_CTX->stageData.numWitnesses);
+		const bip44_path_t* path = &WITNESS_CTX->stageData.paths[WITNESS_CTX->stageData.currentDisplayedWitness];
+		WITNESS_CTX->stageData.currentDisplayedWitness++;
+
 		#ifdef HAVE_BAGL
-		ui_displayPathScreen("Witness path", &WITNESS_CTX->stageData.witness.path, this_fn);
+		ui_displayPathScreen("Witness path", path, this_fn);
 		#elif defined(HAVE_NBGL)
 		set_light_confirmation(true);
 		char pathStr[BIP44_PATH_STRING_SIZE_MAX + 1] = {0};
-		ui_getPathScreen(pathStr, SIZEOF(pathStr), &WITNESS_CTX->stageData.witness.path);
+		ui_getPathScreen(pathStr, SIZEOF(pathStr), path);
 		fill_and_display_if_required("Witness path", pathStr, this_fn, respond_with_user_reject);
 		#endif // HAVE_BAGL
 	}
+	UI_STEP(HANDLE_WITNESS_STEP_DISPLAY_NEXT) {
+		if (WITNESS_CTX->stageData.currentDisplayedWitness < WITNESS_CTX->stageData.numWitnesses) {
+			UI_STEP_JUMP(HANDLE_WITNESS_STEP_DISPLAY);
+		}
+		UI_STEP_JUMP(HANDLE_WITNESS_STEP_CONFIRM);
+	}
 	UI_STEP(HANDLE_WITNESS_STEP_CONFIRM) {
 		#ifdef HAVE_BAGL
 		ui_displayPrompt(
 		        "Sign using",
-		        "this witness?",
+		        (WITNESS_CTX->stageData.numWitnesses > 1) ? "these witnesses?" : "this witness?",
 		        this_fn,
-		        _wipeWitnessSignature
+		        _rejectWitnesses
 		);
 		#elif defined(HAVE_NBGL)
-		display_confirmation_no_approved_status("Sign using witness", "", "Signature\nrejected", this_fn, _wipeWitnessSignature);
+		display_confirmation_no_approved_status(
+		        (WITNESS_CTX->stageData.numWitnesses > 1) ? "Sign using witnesses" : "Sign using witness",
+		        "",
+		        "Signature\nrejected",
+		        this_fn,
+		        _rejectWitnesses
+		);
 		#endif // HAVE_BAGL
 	}
 	UI_STEP(HANDLE_WITNESS_STEP_RESPOND) {
+		const size_t responseSize = WITNESS_CTX->stageData.numWitnesses * ED25519_SIGNATURE_LENGTH;
+		ASSERT(responseSize <= SIZEOF(WITNESS_CTX->stageData.signatures));
+
+		#ifdef APP_FEATURE_SIGN_TX_SESSION
+		// the policies of the confirmed witnesses might have stored the single account
+		signTxSession_update();
+		#endif // APP_FEATURE_SIGN_TX_SESSION
+
 		TRACE("Sending witness data");
-		TRACE_BUFFER(WITNESS_CTX->stageData.witness.signature, SIZEOF(WITNESS_CTX->stageData.witness.signature));
-		io_send_buf(SUCCESS, WITNESS_CTX->stageData.witness.signature, SIZEOF(WITNESS_CTX->stageData.witness.signature));
+		TRACE_BUFFER(WITNESS_CTX->stageData.signatures, responseSize);
+		io_send_buf(SUCCESS, (uint8_t*) WITNESS_CTX->stageData.signatures, responseSize);
 		#ifdef HAVE_BAGL
 		ui_displayBusy(); // displays dots, called only after I/O to avoid freezing
 		#endif // HAVE_BAGL
 
-		WITNESS_CTX->currentWitness++;
+		WITNESS_CTX->currentWitness += WITNESS_CTX->stageData.numWitnesses;
+		ASSERT(WITNESS_CTX->currentWitness <= ctx->numWitnesses);
 		if (WITNESS_CTX->currentWitness == ctx->numWitnesses) {
 			tx_advanceStage();
 		}
@@ -38,6 +38,7 @@ void signTx_handleAuxDataCVoteRegistration_ui_runStep();
 
 enum {
 	HANDLE_INPUT_STEP_DISPLAY = 200,
+	HANDLE_INPUT_STEP_DISPLAY_NEXT,
 	HANDLE_INPUT_STEP_RESPOND,
 	HANDLE_INPUT_STEP_INVALID,
 };
@@ -135,6 +136,7 @@ void signTx_handleCertificatePoolRetirement_ui_runStep();
 enum {
 	HANDLE_WITHDRAWAL_STEP_DISPLAY_AMOUNT = 700,
 	HANDLE_WITHDRAWAL_STEP_DISPLAY_PATH,
+	HANDLE_WITHDRAWAL_STEP_DISPLAY_NEXT,
 	HANDLE_WITHDRAWAL_STEP_RESPOND,
 	HANDLE_WITHDRAWAL_STEP_INVALID,
 };
@@ -166,6 +168,7 @@ void signTx_handleScriptDataHash_ui_runStep();
 
 enum {
 	HANDLE_REQUIRED_SIGNERS_STEP_DISPLAY = 1400,
+	HANDLE_REQUIRED_SIGNERS_STEP_DISPLAY_NEXT,
 	HANDLE_REQUIRED_SIGNERS_STEP_RESPOND,
 	HANDLE_REQUIRED_SIGNERS_STEP_INVALID,
 };
@@ -236,6 +239,7 @@ void signTx_handleConfirm_ui_runStep();
 enum {
 	HANDLE_WITNESS_STEP_WARNING = 1100,
 	HANDLE_WITNESS_STEP_DISPLAY,
+	HANDLE_WITNESS_STEP_DISPLAY_NEXT,
 	HANDLE_WITNESS_STEP_CONFIRM,
 	HANDLE_WITNESS_STEP_RESPOND,
 	HANDLE_WITNESS_STEP_INVALID,
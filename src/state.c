@@ -1,4 +1,95 @@
 #include "state.h"
+#include "uiHelpers.h"
 
 instructionState_t instructionState;
 int currentInstruction;
+
+void state_endInstruction()
+{
+	currentInstruction = INS_NONE;
+	// nothing of the instruction is kept for the next one
+	explicit_bzero(&instructionState, SIZEOF(instructionState));
+}
+
+// RAM budgets of the statically allocated state, in bytes.
+// They are the current sizes, so any growth fails the build and has to
+// come with a raised budget; `make ram_report` prints all the sizes.
+// Keyed on APP_XS rather than on the target: a DEVEL build for Nano S
+// has all features and thus the same contexts as Nano X, Stax and Flex.
+// Host builds (fuzzing, native) have different type layouts.
+// The values are not yet confirmed by `make ram_report` on the devices;
+// they come from the ARM EABI layout of the types in ramReport.c
+// (32-bit, 8-byte aligned uint64, short enums) for APP_XS, for the full
+// feature set with BAGL and with NBGL (same sizes) and for HEADLESS.
+// The only SDK type in the contexts is the BLAKE2b hash context, taken
+// as 256 bytes; the budgets holding it grow by the difference if the SDK
+// one is larger (per context held), so the guess cannot fail the build.
+#ifndef FUZZING
+
+#define RAM_BUDGET_BLAKE2B_GROWTH \
+	(sizeof(cx_blake2b_t) > 256 ? sizeof(cx_blake2b_t) - 256 : 0)
+#define RAM_BUDGET_WITH_HASHES(SIZE, NUM_HASHES) \
+	((SIZE) + (NUM_HASHES) * RAM_BUDGET_BLAKE2B_GROWTH)
+
+#ifdef APP_XS
+#define RAM_BUDGET_INSTRUCTION_STATE RAM_BUDGET_WITH_HASHES(1040, 2)
+#define RAM_BUDGET_SIGN_TX_CONTEXT RAM_BUDGET_WITH_HASHES(1040, 2)
+#define RAM_BUDGET_SIGN_TX_AUX_DATA_CONTEXT RAM_BUDGET_WITH_HASHES(760, 2)
+#define RAM_BUDGET_SIGN_TX_BODY_CONTEXT RAM_BUDGET_WITH_HASHES(872, 1)
+#define RAM_BUDGET_SIGN_CVOTE_CONTEXT RAM_BUDGET_WITH_HASHES(560, 1)
+#else
+#define RAM_BUDGET_INSTRUCTION_STATE RAM_BUDGET_WITH_HASHES(1416, 2)
+#define RAM_BUDGET_SIGN_TX_CONTEXT RAM_BUDGET_WITH_HASHES(1416, 2)
+#define RAM_BUDGET_SIGN_TX_AUX_DATA_CONTEXT RAM_BUDGET_WITH_HASHES(1032, 2)
+#define RAM_BUDGET_SIGN_TX_BODY_CONTEXT RAM_BUDGET_WITH_HASHES(1008, 1)
+#define RAM_BUDGET_SIGN_CVOTE_CONTEXT RAM_BUDGET_WITH_HASHES(696, 1)
+#define RAM_BUDGET_DERIVE_NATIVE_SCRIPT_HASH_CONTEXT RAM_BUDGET_WITH_HASHES(616, 1)
+#define RAM_BUDGET_SIGN_OP_CERT_CONTEXT 152
+#define RAM_BUDGET_POOL_REGISTRATION_CONTEXT 192
+#endif // APP_XS
+
+#define RAM_BUDGET_GET_KEYS_CONTEXT 284
+#define RAM_BUDGET_DERIVE_ADDRESS_CONTEXT 332
+#define RAM_BUDGET_SIGN_MSG_CONTEXT RAM_BUDGET_WITH_HASHES(896, 1)
+#define RAM_BUDGET_SIGN_TX_WITNESS_CONTEXT 804
+#define RAM_BUDGET_CVOTE_REGISTRATION_CONTEXT 208
+#define RAM_BUDGET_OUTPUT_CONTEXT 296
+#define RAM_BUDGET_MINT_CONTEXT 280
+
+#ifdef HEADLESS
+#define RAM_BUDGET_DISPLAY_STATE 272
+#else
+#define RAM_BUDGET_DISPLAY_STATE 268
+#endif // HEADLESS
+
+#define RAM_BUDGET_MESSAGE " over its RAM budget in state.c, see make ram_report"
+
+STATIC_ASSERT(sizeof(instructionState_t) <= RAM_BUDGET_INSTRUCTION_STATE, "instructionState_t" RAM_BUDGET_MESSAGE);
+
+STATIC_ASSERT(sizeof(ins_get_keys_context_t) <= RAM_BUDGET_GET_KEYS_CONTEXT, "ins_get_keys_context_t" RAM_BUDGET_MESSAGE);
+STATIC_ASSERT(sizeof(ins_derive_address_context_t) <= RAM_BUDGET_DERIVE_ADDRESS_CONTEXT, "ins_derive_address_context_t" RAM_BUDGET_MESSAGE);
+#ifdef APP_FEATURE_NATIVE_SCRIPT_HASH
+STATIC_ASSERT(sizeof(ins_derive_native_script_hash_context_t) <= RAM_BUDGET_DERIVE_NATIVE_SCRIPT_HASH_CONTEXT, "ins_derive_native_script_hash_context_t" RAM_BUDGET_MESSAGE);
+#endif // APP_FEATURE_NATIVE_SCRIPT_HASH
+STATIC_ASSERT(sizeof(ins_sign_tx_context_t) <= RAM_BUDGET_SIGN_TX_CONTEXT, "ins_sign_tx_context_t" RAM_BUDGET_MESSAGE);
+#ifdef APP_FEATURE_OPCERT
+STATIC_ASSERT(sizeof(ins_sign_op_cert_context_t) <= RAM_BUDGET_SIGN_OP_CERT_CONTEXT, "ins_sign_op_cert_context_t" RAM_BUDGET_MESSAGE);
+#endif // APP_FEATURE_OPCERT
+STATIC_ASSERT(sizeof(ins_sign_cvote_context_t) <= RAM_BUDGET_SIGN_CVOTE_CONTEXT, "ins_sign_cvote_context_t" RAM_BUDGET_MESSAGE);
+STATIC_ASSERT(sizeof(ins_sign_msg_context_t) <= RAM_BUDGET_SIGN_MSG_CONTEXT, "ins_sign_msg_context_t" RAM_BUDGET_MESSAGE);
+
+STATIC_ASSERT(sizeof(ins_sign_tx_aux_data_context_t) <= RAM_BUDGET_SIGN_TX_AUX_DATA_CONTEXT, "ins_sign_tx_aux_data_context_t" RAM_BUDGET_MESSAGE);
+STATIC_ASSERT(sizeof(ins_sign_tx_body_context_t) <= RAM_BUDGET_SIGN_TX_BODY_CONTEXT, "ins_sign_tx_body_context_t" RAM_BUDGET_MESSAGE);
+STATIC_ASSERT(sizeof(ins_sign_tx_witness_context_t) <= RAM_BUDGET_SIGN_TX_WITNESS_CONTEXT, "ins_sign_tx_witness_context_t" RAM_BUDGET_MESSAGE);
+STATIC_ASSERT(sizeof(cvote_registration_context_t) <= RAM_BUDGET_CVOTE_REGISTRATION_CONTEXT, "cvote_registration_context_t" RAM_BUDGET_MESSAGE);
+#ifdef APP_FEATURE_POOL_REGISTRATION
+STATIC_ASSERT(sizeof(pool_registration_context_t) <= RAM_BUDGET_POOL_REGISTRATION_CONTEXT, "pool_registration_context_t" RAM_BUDGET_MESSAGE);
+#endif // APP_FEATURE_POOL_REGISTRATION
+STATIC_ASSERT(sizeof(output_context_t) <= RAM_BUDGET_OUTPUT_CONTEXT, "output_context_t" RAM_BUDGET_MESSAGE);
+#ifdef APP_FEATURE_TOKEN_MINTING
+STATIC_ASSERT(sizeof(mint_context_t) <= RAM_BUDGET_MINT_CONTEXT, "mint_context_t" RAM_BUDGET_MESSAGE);
+#endif // APP_FEATURE_TOKEN_MINTING
+
+STATIC_ASSERT(sizeof(displayState_t) <= RAM_BUDGET_DISPLAY_STATE, "displayState_t" RAM_BUDGET_MESSAGE);
+
+#endif // FUZZING
@@ -27,8 +27,17 @@ typedef union {
 } instructionState_t;
 
 // Note(instructions are uint8_t but we have a special INS_NONE value
+#define INS_NONE (-1)
 extern int currentInstruction;
 
 extern instructionState_t instructionState;
 
+// ends the current instruction and wipes the whole state,
+// called when it finished or was rejected by the user (via ui_idle)
+void state_endInstruction();
+
+#ifdef DEVEL
+void run_state_test();
+#endif // DEVEL
+
 #endif // H_CARDANO_APP_STATE
@@ -0,0 +1,52 @@
+#ifdef DEVEL
+
+#include "state.h"
+#include "handlers.h"
+#include "testUtils.h"
+
+static void expectWiped()
+{
+	const uint8_t* bytes = (const uint8_t*) &instructionState;
+	for (size_t i = 0; i < SIZEOF(instructionState); i++) {
+		EXPECT_EQ(bytes[i], 0);
+	}
+}
+
+// a finished instruction must not leave anything for the next one,
+// which clears just its own variant when it starts (see handleApdu)
+static void testEndInstruction()
+{
+	PRINTF("testEndInstruction\n");
+
+	for (int ins = 0; ins <= 0xff; ins++) {
+		if (lookupHandler((uint8_t) ins) == NULL) {
+			continue;
+		}
+		// asserts unless the instruction is listed by lookupInstructionStateSize
+		const size_t stateSize = lookupInstructionStateSize((uint8_t) ins);
+		EXPECT_EQ(stateSize <= SIZEOF(instructionState), true);
+
+		memset(&instructionState, 0xa5, SIZEOF(instructionState));
+		currentInstruction = INS_SIGN_TX;
+
+		state_endInstruction();
+
+		EXPECT_EQ(currentInstruction, INS_NONE);
+		expectWiped();
+
+		explicit_bzero(&instructionState, stateSize);
+		expectWiped();
+	}
+}
+
+void run_state_test()
+{
+	// the tests run within INS_RUN_TESTS
+	const int instruction = currentInstruction;
+
+	testEndInstruction();
+
+	currentInstruction = instruction;
+}
+
+#endif // DEVEL
@@ -1,60 +1,89 @@
 #include "textUtils.h"
 #include "hexUtils.h"
 
-#define WRITE_CHAR(ptr, end, c) \
-	{ \
-		ASSERT(ptr + 1 <= end); \
-		*ptr = (c); \
-		ptr++; \
+/* cspell:disable-next-line */
+static const char DIGIT_PAIRS[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+// POWERS_OF_10[i] == 10^(i + 1)
+static const uint64_t POWERS_OF_10[] = {
+	10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u,
+	10000000000u, 100000000000u, 1000000000000u, 10000000000000u, 100000000000000u,
+	1000000000000000u, 10000000000000000u, 100000000000000000u, 1000000000000000000u,
+	10000000000000000000u
+};
+
+static size_t decimalDigitCount(uint64_t number)
+{
+	size_t count = 1;
+	while ((count <= ARRAY_LEN(POWERS_OF_10)) && (number >= POWERS_OF_10[count - 1])) {
+		count++;
 	}
+	return count;
+}
 
-size_t str_formatDecimalAmount(uint64_t amount, size_t places, char* out, size_t outSize)
+// Prints the number with a decimal point before the last places digits
+// and, if required, thousands separators in the integer part.
+// The length is known up front, so the digits are written straight to their positions
+// in out (from the end), two digits per division.
+static size_t formatDecimal(uint64_t number, size_t places, bool separateThousands, char* out, size_t outSize)
 {
 	ASSERT(outSize < BUFFER_SIZE_PARANOIA);
 	ASSERT(places <= UINT8_MAX);
 
-	char scratchBuffer[40] = {0};
-	explicit_bzero(scratchBuffer, SIZEOF(scratchBuffer));
-	char* ptr = BEGIN(scratchBuffer);
-	char* end = END(scratchBuffer);
+	// at least one digit before the decimal point
+	const size_t digits = MAX(decimalDigitCount(number), places + 1);
+	const size_t integerDigits = digits - places;
+	const size_t separators = separateThousands ? (integerDigits - 1) / 3 : 0;
+	const size_t length = digits + separators + ((places > 0) ? 1 : 0);
+	ASSERT(length + 1 <= outSize);
 
-	// We print in reverse
+	char* ptr = out + length;
+	*ptr = '\0';
 
-	// decimal digits
-	for (size_t dec = 0; dec < places; dec++) {
-		WRITE_CHAR(ptr, end, '0' + (amount % 10));
-		amount /= 10;
-	}
-	if (places > 0) {
-		WRITE_CHAR(ptr, end, '.');
+	// digitIndex counts the digits already written, from the least significant one
+	size_t digitIndex = 0;
+#define PUT_DIGIT(c) \
+	{ \
+		if ((places > 0) && (digitIndex == places)) { \
+			*(--ptr) = '.'; \
+		} else if (separateThousands && (digitIndex > places) && ((digitIndex - places) % 3 == 0)) { \
+			*(--ptr) = ','; \
+		} \
+		*(--ptr) = (c); \
+		digitIndex++; \
 	}
-	// We want at least one iteration
-	int place = 0;
-	do {
-		// thousands separator
-		if (place && (place % 3 == 0)) {
-			WRITE_CHAR(ptr, end, ',');
-		}
-		WRITE_CHAR(ptr, end, '0' + (amount % 10));
-		amount /= 10;
-		place++;
-	} while (amount > 0);
-
-	// Size without terminating character
-	STATIC_ASSERT(sizeof(ptr - scratchBuffer) == sizeof(size_t), "bad size_t size");
-	size_t rawSize = (size_t) (ptr - scratchBuffer);
-	ASSERT(rawSize + 1 <= outSize);
 
-	// Copy reversed & append terminator
-	for (size_t i = 0; i < rawSize; i++) {
-		out[i] = scratchBuffer[rawSize - 1 - i];
+	while (digitIndex + 2 <= digits) {
+		const size_t pair = (size_t) (number % 100);
+		number /= 100;
+		PUT_DIGIT(DIGIT_PAIRS[2 * pair + 1]);
+		PUT_DIGIT(DIGIT_PAIRS[2 * pair]);
 	}
-	out[rawSize] = 0;
+	if (digitIndex < digits) {
+		PUT_DIGIT((char) ('0' + number % 10));
+	}
+#undef PUT_DIGIT
 
+	ASSERT(ptr == out);
 	// make sure all the information is displayed to the user
-	ASSERT(strlen(out) == rawSize);
+	ASSERT(strlen(out) == length);
 
-	return rawSize;
+	return length;
+}
+
+size_t str_formatDecimalAmount(uint64_t amount, size_t places, char* out, size_t outSize)
+{
+	return formatDecimal(amount, places, true, out, outSize);
 }
 
 size_t str_formatAdaAmount(uint64_t amount, char* out, size_t outSize)
@@ -75,50 +104,9 @@ size_t str_formatAdaAmount(uint64_t amount, char* out, size_t outSize)
 	return rawSize + suffixLength;
 }
 
-static size_t stringifyUint64ToBufferReverse(uint64_t number, char* buffer, size_t bufferSize)
-{
-	char* currChar = buffer;
-	char* const end = buffer + bufferSize;
-
-	// We print in reverse
-	// We want at least one iteration
-	size_t printedChars = 0;
-	do {
-		WRITE_CHAR(currChar, end, '0' + (number % 10));
-		number /= 10;
-		++printedChars;
-	} while (number > 0);
-	WRITE_CHAR(currChar, end, '\0');
-	return printedChars;
-}
-
-static void printReversedStringToBuffer(const char* reversed, char* out, size_t outSize)
-{
-	const size_t reversedSize = strlen(reversed);
-	ASSERT(outSize >= reversedSize + 1);
-
-	for (size_t i = 0; i < reversedSize; i++) {
-		out[i] = reversed[reversedSize - 1 - i];
-	}
-	out[reversedSize] = 0;
-
-	ASSERT(strlen(out) == reversedSize);
-}
-
 size_t str_formatUint64(uint64_t number, char* out, size_t outSize)
 {
-	ASSERT(outSize < BUFFER_SIZE_PARANOIA);
-
-	{
-		char tmpReversed[30] = {0};
-		explicit_bzero(tmpReversed, SIZEOF(tmpReversed));
-
-		stringifyUint64ToBufferReverse(number, tmpReversed, SIZEOF(tmpReversed));
-		const size_t reversedSize = strlen(tmpReversed);
-		printReversedStringToBuffer(tmpReversed, out, outSize);
-		ASSERT(strlen(out) == reversedSize);
-	}
-	return strlen(out);
+	return formatDecimal(number, 0, false, out, outSize);
 }
 
 uint64_t abs_int64(int64_t number)
@@ -138,24 +126,75 @@ size_t str_formatInt64(int64_t number, char* out, size_t outSize)
 {
 	ASSERT(outSize < BUFFER_SIZE_PARANOIA);
 
-	const uint64_t signlessNumber = abs_int64(number);
-	{
-		char tmpReversed[30] = {0};
-		explicit_bzero(tmpReversed, SIZEOF(tmpReversed));
-		//size without the potential '-' sign
-		stringifyUint64ToBufferReverse(signlessNumber, tmpReversed, SIZEOF(tmpReversed) - 1);
-		size_t reversedLength = strlen(tmpReversed);
-		if (number < 0) {
-			snprintf(tmpReversed + reversedLength, SIZEOF(tmpReversed) - reversedLength, "%c", '-');
-			++reversedLength;
-		}
-		printReversedStringToBuffer(tmpReversed, out, outSize);
-		ASSERT(strlen(out) == reversedLength);
+	if (number >= 0) {
+		return str_formatUint64((uint64_t) number, out, outSize);
 	}
-	return strlen(out);
+
+	ASSERT(outSize >= 1);
+	out[0] = '-';
+	return 1 + str_formatUint64(abs_int64(number), out + 1, outSize - 1);
 }
 
 #ifdef DEVEL
+
+#define WRITE_CHAR(ptr, end, c) \
+	{ \
+		ASSERT(ptr + 1 <= end); \
+		*ptr = (c); \
+		ptr++; \
+	}
+
+// the previous implementation printing the digits in reverse into a scratch buffer;
+// str_formatDecimalAmount must print exactly the same, separators included
+size_t str_formatDecimalAmount_reversed(uint64_t amount, size_t places, char* out, size_t outSize)
+{
+	ASSERT(outSize < BUFFER_SIZE_PARANOIA);
+	ASSERT(places <= UINT8_MAX);
+
+	char scratchBuffer[40] = {0};
+	explicit_bzero(scratchBuffer, SIZEOF(scratchBuffer));
+	char* ptr = BEGIN(scratchBuffer);
+	char* end = END(scratchBuffer);
+
+	// We print in reverse
+
+	// decimal digits
+	for (size_t dec = 0; dec < places; dec++) {
+		WRITE_CHAR(ptr, end, '0' + (amount % 10));
+		amount /= 10;
+	}
+	if (places > 0) {
+		WRITE_CHAR(ptr, end, '.');
+	}
+	// We want at least one iteration
+	int place = 0;
+	do {
+		// thousands separator
+		if (place && (place % 3 == 0)) {
+			WRITE_CHAR(ptr, end, ',');
+		}
+		WRITE_CHAR(ptr, end, '0' + (amount % 10));
+		amount /= 10;
+		place++;
+	} while (amount > 0);
+
+	// Size without terminating character
+	STATIC_ASSERT(sizeof(ptr - scratchBuffer) == sizeof(size_t), "bad size_t size");
+	size_t rawSize = (size_t) (ptr - scratchBuffer);
+	ASSERT(rawSize + 1 <= outSize);
+
+	// Copy reversed & append terminator
+	for (size_t i = 0; i < rawSize; i++) {
+		out[i] = scratchBuffer[rawSize - 1 - i];
+	}
+	out[rawSize] = 0;
+
+	// make sure all the information is displayed to the user
+	ASSERT(strlen(out) == rawSize);
+
+	return rawSize;
+}
+
 void str_traceAdaAmount(const char* prefix, uint64_t amount)
 {
 	char adaAmountStr[100] = {0};
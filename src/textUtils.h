@@ -11,6 +11,10 @@ size_t str_formatAdaAmount(uint64_t amount, char* out, size_t outSize);
 size_t str_formatUint64(uint64_t number, char* out, size_t outSize);
 size_t str_formatInt64(int64_t number, char* out, size_t outSize);
 
+#ifdef DEVEL
+size_t str_formatDecimalAmount_reversed(uint64_t amount, size_t places, char* out, size_t outSize);
+#endif // DEVEL
+
 #ifdef DEVEL
 void str_traceAdaAmount(const char* prefix, uint64_t amount);
 #define TRACE_ADA_AMOUNT(PREFIX, AMOUNT) \
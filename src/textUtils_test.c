@@ -3,6 +3,7 @@
 #include "common.h"
 #include "textUtils.h"
 #include "testUtils.h"
+#include "cardano.h"
 
 void testcase_formatDecimal(
         uint64_t amount,
@@ -182,9 +183,92 @@ void test_formatInt64()
 	testcase_formatInt64( INT64_MIN, "-9223372036854775808");
 }
 
+// compares the formatting with the previous implementation
+static void testcase_formatDecimalMatchesReversed(uint64_t amount, size_t places)
+{
+	char expected[40] = {0};
+	const size_t expectedLen = str_formatDecimalAmount_reversed(amount, places, expected, SIZEOF(expected));
+
+	char formatted[40] = {0};
+	const size_t len = str_formatDecimalAmount(amount, places, formatted, SIZEOF(formatted));
+	EXPECT_EQ(len, expectedLen);
+	EXPECT_EQ(strcmp(formatted, expected), 0);
+
+	// not enough space for the terminator, nothing is written
+	memset(formatted, 'X', SIZEOF(formatted));
+	EXPECT_THROWS(str_formatDecimalAmount(amount, places, formatted, expectedLen), ERR_ASSERT);
+	EXPECT_EQ(formatted[0], 'X');
+
+	if (places > 0) {
+		return;
+	}
+
+	// the same digits without the thousands separators
+	char withoutSeparators[40] = {0};
+	size_t withoutSeparatorsLen = 0;
+	for (size_t i = 0; i < expectedLen; i++) {
+		if (expected[i] != ',') {
+			withoutSeparators[withoutSeparatorsLen++] = expected[i];
+		}
+	}
+
+	char number[40] = {0};
+	EXPECT_EQ(str_formatUint64(amount, number, SIZEOF(number)), withoutSeparatorsLen);
+	EXPECT_EQ(strcmp(number, withoutSeparators), 0);
+
+	if (amount <= (uint64_t) INT64_MAX) {
+		EXPECT_EQ(str_formatInt64((int64_t) amount, number, SIZEOF(number)), withoutSeparatorsLen);
+		EXPECT_EQ(strcmp(number, withoutSeparators), 0);
+	}
+	if ((amount > 0) && (amount - 1 <= (uint64_t) INT64_MAX)) {
+		const int64_t negative = (amount - 1 == (uint64_t) INT64_MAX) ? INT64_MIN : -(int64_t) amount;
+		EXPECT_EQ(str_formatInt64(negative, number, SIZEOF(number)), 1 + withoutSeparatorsLen);
+		EXPECT_EQ(number[0], '-');
+		EXPECT_EQ(strcmp(number + 1, withoutSeparators), 0);
+	}
+}
+
+void test_formatDecimalBoundaries()
+{
+	PRINTF("test_formatDecimalBoundaries\n");
+
+	// around all the powers of 10 and the limits
+	uint64_t boundaries[3 * 20 + 6] = {0};
+	size_t boundariesCount = 0;
+	uint64_t power = 1;
+	for (size_t exponent = 0; exponent < 20; exponent++) {
+		boundaries[boundariesCount++] = power - 1;
+		boundaries[boundariesCount++] = power;
+		boundaries[boundariesCount++] = power + 1;
+		power *= 10;
+	}
+	boundaries[boundariesCount++] = UINT64_MAX;
+	boundaries[boundariesCount++] = UINT64_MAX - 1;
+	boundaries[boundariesCount++] = (uint64_t) INT64_MAX + 1;
+	boundaries[boundariesCount++] = LOVELACE_MAX_SUPPLY - 1;
+	boundaries[boundariesCount++] = LOVELACE_MAX_SUPPLY;
+	boundaries[boundariesCount++] = LOVELACE_MAX_SUPPLY + 1;
+	ASSERT(boundariesCount == ARRAY_LEN(boundaries));
+
+	for (size_t i = 0; i < boundariesCount; i++) {
+		for (size_t places = 0; places <= 30; places++) {
+			testcase_formatDecimalMatchesReversed(boundaries[i], places);
+		}
+	}
+
+	// all small amounts with the usual numbers of decimal places
+	const size_t placesList[] = {0, 1, 2, 3, 6, 8};
+	for (uint64_t amount = 0; amount < 10000; amount++) {
+		for (size_t i = 0; i < ARRAY_LEN(placesList); i++) {
+			testcase_formatDecimalMatchesReversed(amount, placesList[i]);
+		}
+	}
+}
+
 void run_textUtils_test()
 {
 	test_formatDecimal();
+	test_formatDecimalBoundaries();
 	test_formatAda();
 	test_formatTtl();
 	test_formatUint64();
@@ -4,8 +4,6 @@
 #include "hash.h"
 #include "bech32.h"
 
-#define ASSET_FINGERPRINT_SIZE 20
-
 void deriveAssetFingerprintBytes(
         const uint8_t* policyId,
         size_t policyIdSize,
@@ -57,17 +55,69 @@ size_t deriveAssetFingerprintBech32(
 	return len;
 }
 
-typedef struct {
-	uint8_t fingerprint[ASSET_FINGERPRINT_SIZE];
-	uint8_t decimals;
-	const char* ticker;
-} token_info_t;
-
 const token_info_t tokenInfos[] = {
-// a fixed list of most popular tokens
+// a fixed list of most popular tokens, sorted by fingerprint
 #include "../tokenRegistry/token_data.c"
 };
 
+const size_t tokenInfosCount = ARRAY_LEN(tokenInfos);
+
+const token_info_t* tokenInfos_find(
+        const token_info_t* infos, size_t infosCount,
+        const uint8_t* fingerprint, size_t fingerprintSize
+)
+{
+	ASSERT(fingerprintSize == ASSET_FINGERPRINT_SIZE);
+
+	// the searched range is [low, high)
+	size_t low = 0;
+	size_t high = infosCount;
+	while (low < high) {
+		const size_t mid = low + (high - low) / 2;
+		const int cmp = memcmp(infos[mid].fingerprint, fingerprint, ASSET_FINGERPRINT_SIZE);
+		if (cmp == 0) {
+			return &infos[mid];
+		}
+		if (cmp < 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	return NULL;
+}
+
+#define POLICY_PREFIX_SIZE 4
+
+static const uint8_t policyPrefixes[][POLICY_PREFIX_SIZE] = {
+// prefixes of the policy ids in the registry, sorted
+#include "../tokenRegistry/token_policy_prefixes.c"
+};
+
+bool tokens_isPolicyInRegistry(const uint8_t* policyId, size_t policyIdSize)
+{
+	ASSERT(policyIdSize == MINTING_POLICY_ID_SIZE);
+
+	// the searched range is [low, high)
+	size_t low = 0;
+	size_t high = ARRAY_LEN(policyPrefixes);
+	while (low < high) {
+		const size_t mid = low + (high - low) / 2;
+		const int cmp = memcmp(policyPrefixes[mid], policyId, POLICY_PREFIX_SIZE);
+		if (cmp == 0) {
+			return true;
+		}
+		if (cmp < 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	return false;
+}
+
 static const token_info_t* _getTokenInfo(
         const token_group_t* tokenGroup,
         const uint8_t* assetNameBytes, size_t assetNameSize
@@ -75,6 +125,11 @@ static const token_info_t* _getTokenInfo(
 {
 	ASSERT(assetNameSize <= ASSET_NAME_SIZE_MAX);
 
+	if (!tokenGroup->isPolicyInRegistry) {
+		// no need to hash the asset name and search the registry
+		return NULL;
+	}
+
 	uint8_t fingerprintBuffer[ASSET_FINGERPRINT_SIZE];
 	deriveAssetFingerprintBytes(
 	        tokenGroup->policyId, SIZEOF(tokenGroup->policyId),
@@ -82,13 +137,10 @@ static const token_info_t* _getTokenInfo(
 	        fingerprintBuffer, SIZEOF(fingerprintBuffer)
 	);
 
-	for (size_t i = 0; i < ARRAY_LEN(tokenInfos); i++) {
-		if (!memcmp(tokenInfos[i].fingerprint, fingerprintBuffer, ASSET_FINGERPRINT_SIZE)) {
-			return &tokenInfos[i];
-		}
-	}
-
-	return NULL;
+	return tokenInfos_find(
+	               tokenInfos, tokenInfosCount,
+	               fingerprintBuffer, SIZEOF(fingerprintBuffer)
+	       );
 }
 
 size_t str_formatTokenAmountOutput(
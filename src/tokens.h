@@ -4,6 +4,25 @@
 #include "common.h"
 #include "cardano.h"
 
+#define ASSET_FINGERPRINT_SIZE 20
+
+typedef struct {
+	uint8_t fingerprint[ASSET_FINGERPRINT_SIZE];
+	uint8_t decimals;
+	const char* ticker;
+} token_info_t;
+
+// the built-in registry
+extern const token_info_t tokenInfos[];
+extern const size_t tokenInfosCount;
+
+// binary search in a table of token infos sorted by fingerprint
+// (as generated by tokenRegistry/convert.py), NULL if not found
+const token_info_t* tokenInfos_find(
+        const token_info_t* infos, size_t infosCount,
+        const uint8_t* fingerprint, size_t fingerprintSize
+);
+
 __noinline_due_to_stack__
 size_t deriveAssetFingerprintBech32(
         const uint8_t* policyId,
@@ -14,6 +33,10 @@ size_t deriveAssetFingerprintBech32(
         size_t fingerprintMaxSize
 );
 
+// a precheck for the registry lookups, to be stored in token_group_t;
+// false positives are possible (only a prefix of the policy id is compared)
+bool tokens_isPolicyInRegistry(const uint8_t* policyId, size_t policyIdSize);
+
 __noinline_due_to_stack__
 size_t str_formatTokenAmountOutput(
         const token_group_t* tokenGroup,
@@ -105,6 +105,7 @@ void test_decimalPlaces()
 		char tokenAmountStr[60];
 		token_group_t group;
 		memmove(group.policyId, tokenTestCases[i].policyId, MINTING_POLICY_ID_SIZE);
+		group.isPolicyInRegistry = tokens_isPolicyInRegistry(group.policyId, SIZEOF(group.policyId));
 
 		str_formatTokenAmountOutput(
 		        &group,
@@ -124,10 +125,74 @@ void test_decimalPlaces()
 	}
 }
 
+void test_policyPrecheck()
+{
+	EXPECT_EQ(tokens_isPolicyInRegistry(tokenTestCases[0].policyId, MINTING_POLICY_ID_SIZE), true);
+	EXPECT_EQ(tokens_isPolicyInRegistry(tokenTestCases[1].policyId, MINTING_POLICY_ID_SIZE), false);
+
+	// the precheck only skips lookups that would not find anything
+	for (size_t i = 0; i < ARRAY_LEN(tokenTestCases); i++) {
+		char withPrecheck[60];
+		char withoutPrecheck[60];
+		token_group_t group;
+		memmove(group.policyId, tokenTestCases[i].policyId, MINTING_POLICY_ID_SIZE);
+
+		group.isPolicyInRegistry = tokens_isPolicyInRegistry(group.policyId, SIZEOF(group.policyId));
+		str_formatTokenAmountOutput(
+		        &group,
+		        tokenTestCases[i].assetNameBytes, tokenTestCases[i].assetNameSize,
+		        tokenTestCases[i].amountOutput,
+		        withPrecheck, SIZEOF(withPrecheck)
+		);
+
+		group.isPolicyInRegistry = true;
+		str_formatTokenAmountOutput(
+		        &group,
+		        tokenTestCases[i].assetNameBytes, tokenTestCases[i].assetNameSize,
+		        tokenTestCases[i].amountOutput,
+		        withoutPrecheck, SIZEOF(withoutPrecheck)
+		);
+
+		EXPECT_EQ(strcmp(withPrecheck, withoutPrecheck), 0);
+	}
+}
+
+void test_tokenInfosLookup()
+{
+	// the lookup relies on the registry being sorted, see tokenRegistry/convert.py
+	for (size_t i = 1; i < tokenInfosCount; i++) {
+		EXPECT_EQ(memcmp(tokenInfos[i - 1].fingerprint, tokenInfos[i].fingerprint, ASSET_FINGERPRINT_SIZE) < 0, true);
+	}
+
+	for (size_t i = 0; i < tokenInfosCount; i++) {
+		const token_info_t* found = tokenInfos_find(
+		                                    tokenInfos, tokenInfosCount,
+		                                    tokenInfos[i].fingerprint, ASSET_FINGERPRINT_SIZE
+		                            );
+		EXPECT_EQ(found == &tokenInfos[i], true);
+	}
+
+	// below, between and above the entries
+	const token_info_t infos[] = {
+		{ { 0x10 }, 0, "A" },
+		{ { 0x20 }, 0, "B" },
+		{ { 0x20, 0x01 }, 0, "C" },
+	};
+	const uint8_t missing[][ASSET_FINGERPRINT_SIZE] = {
+		{ 0x00 }, { 0x10, 0x01 }, { 0x20, 0x00, 0x01 }, { 0xff },
+	};
+	for (size_t i = 0; i < ARRAY_LEN(missing); i++) {
+		EXPECT_EQ(tokenInfos_find(infos, ARRAY_LEN(infos), missing[i], ASSET_FINGERPRINT_SIZE) == NULL, true);
+	}
+	EXPECT_EQ(tokenInfos_find(infos, 0, infos[0].fingerprint, ASSET_FINGERPRINT_SIZE) == NULL, true);
+}
+
 void run_tokens_test()
 {
 	test_assetFingerprint();
 	test_decimalPlaces();
+	test_policyPrecheck();
+	test_tokenInfosLookup();
 }
 
 #endif
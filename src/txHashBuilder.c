@@ -31,24 +31,26 @@ The following macros and functions have dual purpose:
 
 
 static void blake2b_256_append_buffer_tx_body(
-        blake2b_256_context_t* hashCtx,
+        blake2b_256_buffered_context_t* hashCtx,
         const uint8_t* buffer, size_t bufferSize
 )
 {
 	TRACE_BUFFER(buffer, bufferSize);
-	blake2b_256_append(hashCtx, buffer, bufferSize);
+	blake2b_256_buffered_append(hashCtx, buffer, bufferSize);
 }
 
 __noinline_due_to_stack__
 static void blake2b_256_append_cbor_tx_body(
-        blake2b_256_context_t* hashCtx,
+        blake2b_256_buffered_context_t* hashCtx,
         uint8_t type, uint64_t value
 )
 {
-	uint8_t buffer[10] = {0};
-	size_t size = cbor_writeToken(type, value, buffer, SIZEOF(buffer));
-	TRACE_BUFFER(buffer, size);
-	blake2b_256_append(hashCtx, buffer, size);
+	// the token is encoded straight into the hash buffer
+	uint8_t scratch[CBOR_TOKEN_SIZE_MAX] = {0};
+	uint8_t* token = blake2b_256_buffered_reserve(hashCtx, scratch, SIZEOF(scratch));
+	size_t size = cbor_writeToken(type, value, token, SIZEOF(scratch));
+	TRACE_BUFFER(token, size);
+	blake2b_256_buffered_commit(hashCtx, token, size);
 }
 
 #define BUILDER_TAG_CBOR_SET() \
@@ -270,7 +272,7 @@ void txHashBuilder_init(
 
 	builder->tagCborSets = tagCborSets;
 
-	blake2b_256_init(&builder->txHash);
+	blake2b_256_buffered_init(&builder->txHash);
 
 	{
 		size_t numItems = 0;
@@ -2350,7 +2352,7 @@ void txHashBuilder_finalize(tx_hash_builder_t* builder, uint8_t* outBuffer, size
 
 	ASSERT(outSize == TX_HASH_LENGTH);
 	{
-		blake2b_256_finalize(&builder->txHash, outBuffer, outSize);
+		blake2b_256_buffered_finalize(&builder->txHash, outBuffer, outSize);
 	}
 
 	builder->state = TX_HASH_BUILDER_FINISHED;
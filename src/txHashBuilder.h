@@ -250,7 +250,7 @@ typedef struct {
 
 
 	tx_hash_builder_state_t state;
-	blake2b_256_context_t txHash;
+	blake2b_256_buffered_context_t txHash;
 } tx_hash_builder_t;
 
 typedef struct {
@@ -6,6 +6,7 @@
 #include "io.h"
 #include "utils.h"
 #include "securityPolicy.h"
+#include "perfCounters.h"
 #include "ui.h"
 
 displayState_t displayState;
@@ -132,6 +133,7 @@ void ui_displayPrompt(
         ui_callback_fn_t* reject)
 {
 	TRACE_STACK_USAGE();
+	PERF_COUNTERS_ADD(uiScreens, 1);
 	TRACE("%s", headerStr);
 	TRACE("%s", bodyStr);
 
@@ -169,6 +171,7 @@ void ui_displayPaginatedText(
         ui_callback_fn_t* callback)
 {
 	TRACE_STACK_USAGE();
+	PERF_COUNTERS_ADD(uiScreens, 1);
 	TRACE("%s", headerStr);
 	TRACE("%s", bodyStr);
 
@@ -35,10 +35,12 @@ extern bolos_ux_params_t G_ux_params;
 			default: { \
 				ASSERT(false);
 
-#ifdef FUZZING
+#if defined(FUZZING) && !defined(NATIVE_STEPPED_UI)
 // Flatten UI control flows. Every step will be
 // called and validated without manual interaction
 // Starting from the first defined step
+// (the native build keeps the steps with NATIVE_STEPPED_UI,
+// its runner then confirms the screens one by one)
 #define UI_STEP(NEXT_STEP) \
 				*__ui_step_ptr = NEXT_STEP; \
 			} \
@@ -50,7 +52,7 @@ extern bolos_ux_params_t G_ux_params;
 				break; \
 			} \
 			case NEXT_STEP: {
-#endif // FUZZING
+#endif // FUZZING && !NATIVE_STEPPED_UI
 
 #define UI_STEP_END(INVALID_STEP) \
 				*__ui_step_ptr = INVALID_STEP; \
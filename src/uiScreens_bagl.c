@@ -11,13 +11,11 @@
 #include "uiHelpers.h"
 #include "menu.h"
 
-static const int INS_NONE = -1;
-
 // ui_idle displays the main menu. Note that your app isn't required to use a
 // menu as its idle screen; you can define your own completely custom screen.
 void ui_idle(void)
 {
-	currentInstruction = INS_NONE;
+	state_endInstruction();
 
 	clear_timer();
 	#if defined(TARGET_NANOS)
@@ -876,10 +874,10 @@ void ui_displayIpPortScreen(
 #endif // APP_FEATURE_POOL_REGISTRATION
 
 void ui_displayInputScreen(
-        const sign_tx_transaction_input_t* input,
+        const char* label,
+        const tx_input_t* inputData,
         ui_callback_fn_t callback)
 {
-	const tx_input_t* inputData = &input->input_data;
 	ASSERT(SIZEOF(inputData->txHashBuffer) == TX_HASH_LENGTH);
 	char txHex[2 * TX_HASH_LENGTH + 1] = {0};
 	explicit_bzero(txHex, SIZEOF(txHex));
@@ -901,7 +899,7 @@ void ui_displayInputScreen(
 	ASSERT(strlen(inputStr) + 1 < SIZEOF(inputStr));
 
 	ui_displayPaginatedText(
-	        input->label,
+	        label,
 	        inputStr,
 	        callback
 	);
@@ -173,7 +173,8 @@ void ui_displayIpPortScreen(
 
 __noinline_due_to_stack__
 void ui_displayInputScreen(
-        const sign_tx_transaction_input_t* input,
+        const char* label,
+        const tx_input_t* inputData,
         ui_callback_fn_t callback
 );
 
@@ -755,9 +755,8 @@ void ui_getIpPortScreen(
 void ui_getInputScreen(
         char* line,
         const size_t lineSize,
-        const sign_tx_transaction_input_t* input)
+        const tx_input_t* inputData)
 {
-	const tx_input_t* inputData = &input->input_data;
 	ASSERT(SIZEOF(inputData->txHashBuffer) == TX_HASH_LENGTH);
 	char txHex[2 * TX_HASH_LENGTH + 1] = {0};
 	explicit_bzero(txHex, SIZEOF(txHex));
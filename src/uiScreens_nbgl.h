@@ -208,7 +208,7 @@ __noinline_due_to_stack__
 void ui_getInputScreen(
         char* line,
         const size_t lineSize,
-        const sign_tx_transaction_input_t* input
+        const tx_input_t* inputData
 );
 
 #endif // H_CARDANO_APP_UI_SCREENS_NBGL
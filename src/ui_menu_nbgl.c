@@ -58,8 +58,6 @@ static const nbgl_genericContents_t settingContents = {.callbackCallNeeded = fal
 													   .contentsList = contents,
 													   .nbContents = SETTING_CONTENTS_NB};
 
-static const int INS_NONE = -1;
-
 // Settings
 static void exit(void)
 {
@@ -98,6 +96,6 @@ void ui_idle_flow(void)
 
 void ui_idle(void)
 {
-	currentInstruction = INS_NONE;
+	state_endInstruction();
 }
 #endif	// HAVE_NBGL
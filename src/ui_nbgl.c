@@ -16,6 +16,7 @@
 #ifdef HAVE_NBGL
 #include "app_mode.h"
 #include "nbgl_use_case.h"
+#include "perfCounters.h"
 #include "state.h"
 #include "ui.h"
 #include "uiHelpers.h"
@@ -178,6 +179,7 @@ static void display_callback(int token, unsigned char index)
 static void _display_confirmation(void)
 {
 	TRACE("_confirmation");
+	PERF_COUNTERS_ADD(uiScreens, 1);
 
 	release_context();
 
@@ -222,6 +224,7 @@ static void light_confirm_callback(bool confirm)
 static void _display_light_confirmation(void)
 {
 	TRACE("_light_confirmation");
+	PERF_COUNTERS_ADD(uiScreens, 1);
 
 	// TODO "reject transaction" is used as a constant string in several places
 	// and then applied also for signing messages and operational certificates.
@@ -281,6 +284,7 @@ static void display_cancel_status(void)
 static void _display_page(void)
 {
 	TRACE("_page");
+	PERF_COUNTERS_ADD(uiScreens, 1);
 
 	release_context();
 
@@ -320,6 +324,7 @@ static void _display_page(void)
 static void _display_prompt(void)
 {
 	TRACE("_prompt");
+	PERF_COUNTERS_ADD(uiScreens, 1);
 
 	nbgl_useCaseReviewStart(&C_cardano_64, uiContext.pageText[0],
 	                        uiContext.pageText[1], "Reject transaction",
@@ -333,6 +338,7 @@ static void _display_prompt(void)
 static void _display_warning(void)
 {
 	TRACE("_warning");
+	PERF_COUNTERS_ADD(uiScreens, 1);
 
 	nbgl_useCaseReviewStart(&C_warning64px, "WARNING",
 	                        uiContext.pageText[0], "Reject if not sure",
@@ -355,6 +361,7 @@ static void display_choice_callback(bool choice)
 static void _display_choice(void)
 {
 	TRACE("_choice");
+	PERF_COUNTERS_ADD(uiScreens, 1);
 
 	nbgl_useCaseChoice(&C_round_warning_64px, uiContext.pageText[0],
 	                   uiContext.pageText[1], "Allow", "Don't Allow",
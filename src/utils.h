@@ -117,10 +117,14 @@
 #define APP_STACK_CANARY_MAGIC 0xDEAD0031
 extern unsigned int app_stack_canary;
 
+// see perfCounters.c
+void perfCounters_recordStackPosition(int position);
+
 #define TRACE_STACK_USAGE() \
 	do { \
 		volatile uint32_t x = 0; \
 		TRACE("stack position = %d", (int)((void*)&x - (void*)&app_stack_canary)); \
+		perfCounters_recordStackPosition((int)((void*)&x - (void*)&app_stack_canary)); \
 		if (app_stack_canary != APP_STACK_CANARY_MAGIC) { \
 			TRACE("===================== stack overflow ====================="); \
 		} \
@@ -16,9 +16,12 @@ def formatHexByte(b):
 def bytestringToC(bstr):
 	return "{ " + ", ".join([formatHexByte(b) for b in bstr]) + " }"
 
+def fingerprint(tokenEntry):
+	subject = bytes.fromhex(tokenEntry["assetSubject"])
+	return hashlib.blake2b(subject, digest_size=20).digest()
+
 def tokenLine(tokenEntry):
 	subject = bytes.fromhex(tokenEntry["assetSubject"])
-	fingerprint = hashlib.blake2b(subject, digest_size=20).digest()
 
 	policyId = subject[0:28]
 	assetName = subject[28:]
@@ -30,7 +33,7 @@ def tokenLine(tokenEntry):
 		ticker = tokenEntry["name"]
 
 	line = "{ "
-	line += bytestringToC(fingerprint)
+	line += bytestringToC(fingerprint(tokenEntry))
 	line += ", "
 	line += str(tokenEntry["decimals"])
 	line += ", "
@@ -38,9 +41,24 @@ def tokenLine(tokenEntry):
 	line += " }"
 	return line
 
+# the app looks the tokens up by binary search, see tokenInfos_find in src/tokens.c
+registry.sort(key=fingerprint)
+fingerprints = [fingerprint(t) for t in registry]
+assert len(set(fingerprints)) == len(fingerprints), "duplicate tokens in the registry"
+
 allLines = ",\n".join([tokenLine(t) for t in registry])
 
 outputFile = open('token_data.c', 'w')
 outputFile.write(allLines)
 outputFile.write('\n')
 
+# prefixes of the policy ids having an entry in the registry, sorted,
+# tokens of other policies are not looked up (see tokens_isPolicyInRegistry in src/tokens.c)
+POLICY_PREFIX_SIZE = 4
+
+policyPrefixes = sorted(set([bytes.fromhex(t["assetSubject"])[0:POLICY_PREFIX_SIZE] for t in registry]))
+
+outputFile = open('token_policy_prefixes.c', 'w')
+outputFile.write(",\n".join([bytestringToC(p) for p in policyPrefixes]))
+outputFile.write('\n')
+
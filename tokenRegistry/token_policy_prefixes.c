@@ -0,0 +1,126 @@
+{ 0x00, 0x73, 0x94, 0xe3 },
+{ 0x01, 0x71, 0xc9, 0x97 },
+{ 0x02, 0x51, 0x46, 0x86 },
+{ 0x04, 0xb9, 0x53, 0x68 },
+{ 0x09, 0xf2, 0xd4, 0xe4 },
+{ 0x0c, 0x44, 0x21, 0x80 },
+{ 0x0c, 0x78, 0xf6, 0x19 },
+{ 0x0c, 0x92, 0xaa, 0xbe },
+{ 0x0f, 0xd9, 0x81, 0x9a },
+{ 0x1a, 0x71, 0xdc, 0x14 },
+{ 0x1d, 0x7f, 0x33, 0xbd },
+{ 0x1d, 0xd1, 0xa7, 0xdd },
+{ 0x1d, 0xdc, 0xb9, 0xc9 },
+{ 0x1f, 0x4b, 0x1b, 0x27 },
+{ 0x20, 0xcd, 0x68, 0x53 },
+{ 0x24, 0x0f, 0xb0, 0x0e },
+{ 0x24, 0x41, 0xab, 0x33 },
+{ 0x25, 0xf0, 0xfc, 0x24 },
+{ 0x27, 0x9c, 0x90, 0x9f },
+{ 0x29, 0xd2, 0x22, 0xce },
+{ 0x2a, 0xa9, 0xc1, 0x55 },
+{ 0x2a, 0xfb, 0x44, 0x8e },
+{ 0x2b, 0x0a, 0x04, 0xa7 },
+{ 0x2b, 0x28, 0xc8, 0x1d },
+{ 0x2c, 0x96, 0xf4, 0x9b },
+{ 0x2d, 0x58, 0x71, 0x11 },
+{ 0x30, 0x0e, 0xc0, 0xd8 },
+{ 0x38, 0xad, 0x9d, 0xc3 },
+{ 0x42, 0x00, 0x00, 0x02 },
+{ 0x42, 0x47, 0xd5, 0x09 },
+{ 0x47, 0x95, 0x9e, 0x79 },
+{ 0x4c, 0x17, 0xb7, 0x00 },
+{ 0x50, 0x29, 0xee, 0xcc },
+{ 0x51, 0xa5, 0xe2, 0x36 },
+{ 0x53, 0x3b, 0xb9, 0x4a },
+{ 0x54, 0x45, 0x71, 0xc0 },
+{ 0x58, 0x5c, 0xfc, 0xbd },
+{ 0x59, 0xe3, 0x1d, 0x17 },
+{ 0x5a, 0xd8, 0xde, 0xb6 },
+{ 0x5d, 0x16, 0xcc, 0x1a },
+{ 0x5d, 0xac, 0x85, 0x36 },
+{ 0x63, 0x76, 0x64, 0x27 },
+{ 0x67, 0x87, 0xa4, 0x7e },
+{ 0x68, 0x1b, 0x5d, 0x03 },
+{ 0x68, 0x2f, 0xe6, 0x0c },
+{ 0x69, 0x54, 0x26, 0x4b },
+{ 0x6a, 0xc8, 0xef, 0x33 },
+{ 0x6c, 0x86, 0x42, 0x40 },
+{ 0x74, 0x9d, 0x10, 0x1a },
+{ 0x75, 0xfc, 0xc2, 0x76 },
+{ 0x79, 0x14, 0xfa, 0xe2 },
+{ 0x7f, 0x37, 0x6e, 0x3d },
+{ 0x80, 0x4f, 0x55, 0x44 },
+{ 0x86, 0x54, 0xe8, 0xb3 },
+{ 0x86, 0xab, 0xe4, 0x5b },
+{ 0x88, 0x48, 0x92, 0xbc },
+{ 0x88, 0x57, 0x42, 0xcd },
+{ 0x88, 0x69, 0x1a, 0x70 },
+{ 0x8a, 0x1c, 0xfa, 0xe2 },
+{ 0x8d, 0x0a, 0xe3, 0xc5 },
+{ 0x8d, 0xae, 0xfa, 0x39 },
+{ 0x8d, 0xb2, 0x69, 0xc3 },
+{ 0x8e, 0x51, 0x39, 0x89 },
+{ 0x8f, 0x52, 0xf6, 0xa8 },
+{ 0x8f, 0xef, 0x2d, 0x34 },
+{ 0x94, 0xcb, 0xb4, 0xfc },
+{ 0x95, 0xa4, 0x27, 0xe3 },
+{ 0x97, 0x74, 0x7a, 0xa3 },
+{ 0x98, 0x7c, 0x1f, 0x90 },
+{ 0x9a, 0x96, 0x93, 0xa9 },
+{ 0x9a, 0xbf, 0x0a, 0xfd },
+{ 0xa0, 0x02, 0x8f, 0x35 },
+{ 0xa0, 0x0f, 0xdf, 0x4f },
+{ 0xa1, 0xc9, 0x4e, 0x56 },
+{ 0xa3, 0x91, 0x4c, 0xb7 },
+{ 0xa3, 0x93, 0x16, 0x91 },
+{ 0xa4, 0xda, 0x87, 0x64 },
+{ 0xa8, 0x95, 0x68, 0xbb },
+{ 0xaa, 0x27, 0x97, 0x73 },
+{ 0xac, 0x01, 0x5c, 0x38 },
+{ 0xae, 0xa1, 0xce, 0xb3 },
+{ 0xaf, 0x2e, 0x27, 0xf5 },
+{ 0xaf, 0xc9, 0x10, 0xd7 },
+{ 0xb0, 0x44, 0x6f, 0x1c },
+{ 0xb0, 0xaf, 0x30, 0xed },
+{ 0xb1, 0x66, 0xa1, 0x04 },
+{ 0xb2, 0x01, 0x92, 0x8d },
+{ 0xb3, 0x4b, 0x3e, 0xa8 },
+{ 0xb4, 0x27, 0x3f, 0x1d },
+{ 0xb6, 0xa7, 0x46, 0x7e },
+{ 0xc0, 0xee, 0x29, 0xa8 },
+{ 0xc2, 0x76, 0x00, 0xf3 },
+{ 0xc4, 0x8c, 0xbb, 0x3d },
+{ 0xc4, 0xc0, 0x0f, 0xbd },
+{ 0xc6, 0x83, 0x07, 0xe7 },
+{ 0xc7, 0xdc, 0xfa, 0x41 },
+{ 0xc9, 0xf9, 0x55, 0xee },
+{ 0xca, 0x94, 0x2c, 0xb8 },
+{ 0xca, 0xff, 0x93, 0x80 },
+{ 0xcc, 0x8d, 0x1b, 0x02 },
+{ 0xcc, 0xb3, 0x57, 0x76 },
+{ 0xcf, 0xee, 0x97, 0xff },
+{ 0xd0, 0x17, 0x94, 0xc4 },
+{ 0xd0, 0x30, 0xb6, 0x26 },
+{ 0xd0, 0xaf, 0x05, 0x6c },
+{ 0xd3, 0x55, 0x86, 0x49 },
+{ 0xd3, 0xa0, 0x34, 0xe4 },
+{ 0xd5, 0xde, 0xc6, 0x07 },
+{ 0xd8, 0x94, 0x89, 0x74 },
+{ 0xda, 0x8c, 0x30, 0x85 },
+{ 0xdb, 0x30, 0xc7, 0x90 },
+{ 0xdb, 0xc3, 0x1b, 0x04 },
+{ 0xdc, 0xa5, 0x4e, 0xcf },
+{ 0xdd, 0xa5, 0xfd, 0xb1 },
+{ 0xe1, 0x4f, 0xe3, 0xab },
+{ 0xe5, 0x29, 0x64, 0xaf },
+{ 0xe9, 0x81, 0x65, 0xa2 },
+{ 0xe9, 0xc2, 0x8a, 0x71 },
+{ 0xed, 0xfd, 0x7a, 0x1d },
+{ 0xf2, 0x8f, 0x45, 0x74 },
+{ 0xf4, 0x36, 0x48, 0x75 },
+{ 0xf4, 0x3a, 0x62, 0xfd },
+{ 0xf4, 0xd9, 0x71, 0x91 },
+{ 0xf5, 0x55, 0xc4, 0x6b },
+{ 0xf6, 0x6d, 0x78, 0xb4 },
+{ 0xf7, 0xc7, 0x77, 0xfd }
@@ -0,0 +1,248 @@
+# reports the worst-case stack depth of every APDU handler and UI step
+#
+# usage: python3 stack_report.py [--budget BYTES] [--nm NM] [--top N] OBJDUMP_FILE OBJ_DIR
+#
+# OBJDUMP_FILE is the disassembly of the linked app (objdump -d),
+# OBJ_DIR holds the *.su files written by -fstack-usage.
+# The frame of a function comes from its .su entry, the call graph
+# from the disassembly. An indirect call is resolved to the functions
+# passed to the caller as arguments and, if the caller dispatches via
+# lookup_subhandler, to the subhandlers of its file; other indirect
+# calls are reported.
+# Recursion is cut at the repeated function and reported too.
+#
+# The handlers of lookupHandler are called by handleApdu; the depth of
+# a handler is added to the frames of the APDU dispatch, and the other
+# calls of handleApdu (starting an instruction) are accounted for too.
+# The UI steps (the *_ui_runStep functions) also run after a confirmation,
+# from the event loop: io_exchange in cardano_main calls io_event,
+# which reaches them through the UX library and uiCallback_confirm.
+# The UX library calls the screens' callbacks indirectly, so the depth
+# of io_event itself (its deepest direct chain) stands in for the frames
+# between io_event and uiCallback_confirm, which overestimates them.
+#
+# The budget defaults to the stack of the linked app (app_stack_canary
+# to _estack, read with nm); the script exits with 1 if a handler or
+# a UI step together with its dispatch goes over it.
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+HANDLERS_FILE = "src/handlers.c"
+# the frames between the reset handler and the called APDU handler
+DISPATCH_CHAIN = ["main", "cardano_main", "handleApdu"]
+DISPATCH_FUNCTION = "handleApdu"
+# the frames between the reset handler and the UI event handler,
+# the event handler and the UI callback are added as described above
+EVENT_CHAIN = ["main", "cardano_main", "io_exchange"]
+EVENT_HANDLER = "io_event"
+UI_CALLBACK = "uiCallback_confirm"
+UI_STEP_RE = re.compile(r"_ui_runStep$")
+
+FUNCTION_RE = re.compile(r"^[0-9a-f]+ <([^>]+)>:$")
+# Thumb (device) and x86 (native) mnemonics
+DIRECT_CALL_RE = re.compile(r"\t(bl|blx|b|b\.w|b\.n|call|jmp)\s+[0-9a-f]+ <([^>+]+)>")
+INDIRECT_CALL_RE = re.compile(r"\t(blx\s+r\d+|call\s+\*)")
+# the instruction codes are hex literals or INS_* constants
+HANDLER_CASE_RE = re.compile(r"CASE\(\s*(?:0x[0-9A-Fa-f]+|INS_\w+)\s*,\s*(\w+)\s*\)")
+SUBHANDLER_CASE_RE = re.compile(r"CASE\(\s*\w+\s*,\s*(\w+)\s*\)")
+
+def parseStackUsage(objDir):
+	frames = {}
+	files = {}
+	dynamic = set()
+	for root, _, names in os.walk(objDir):
+		for name in names:
+			if not name.endswith(".su"):
+				continue
+			for line in open(os.path.join(root, name)):
+				location, size, qualifier = line.rstrip("\n").split("\t")
+				fields = location.split(":")
+				function = fields[-1]
+				# static functions of the same name are merged, keep the worst one
+				frames[function] = max(frames.get(function, 0), int(size))
+				files.setdefault(function, set()).add(fields[0])
+				if qualifier != "static":
+					dynamic.add(function)
+	return frames, files, dynamic
+
+def parseCallGraph(objdumpFile):
+	calls = {}
+	indirect = set()
+	current = None
+	for line in open(objdumpFile):
+		match = FUNCTION_RE.match(line.strip())
+		if match:
+			# skips the PLT entries of host builds
+			current = match.group(1) if "@" not in match.group(1) else None
+			if current is None:
+				continue
+			calls.setdefault(current, set())
+			continue
+		if current is None:
+			continue
+		match = DIRECT_CALL_RE.search(line)
+		if match:
+			callee = match.group(2).split("@")[0]
+			# branches inside the function are not calls
+			if callee != current:
+				calls[current].add(callee)
+			continue
+		if INDIRECT_CALL_RE.search(line):
+			indirect.add(current)
+	return calls, indirect
+
+def functionBody(source, function):
+	match = re.search(r"^\w[^;{}]*\b" + re.escape(function) + r"\s*\([^;{}]*\)\s*\{", source, re.M)
+	if not match:
+		return None
+	end = source.find("\n}\n", match.end())
+	return source[match.end():end]
+
+# functions passed as arguments where the caller is called
+def functionArguments(sources, function, known):
+	targets = set()
+	for source in sources.values():
+		for match in re.finditer(r"\b" + re.escape(function) + r"\s*\(([^;]*)\);", source):
+			for name in re.findall(r"\b(\w+)\b(?!\s*\()", match.group(1)):
+				if name in known:
+					targets.add(name)
+	return targets
+
+# the subhandlers from the lookup_subhandler table of the caller's file
+def subhandlers(source, known):
+	body = functionBody(source, "lookup_subhandler")
+	if body is None:
+		return set()
+	return set(name for name in SUBHANDLER_CASE_RE.findall(body) if name in known)
+
+def resolveIndirectCalls(calls, indirect, files):
+	sources = {}
+	for path in set().union(*files.values()):
+		if os.path.exists(path):
+			sources[path] = open(path).read()
+	known = set(files)
+	unresolved = set()
+	for caller in indirect:
+		targets = functionArguments(sources, caller, known)
+		for path in files.get(caller, ()):
+			body = functionBody(sources.get(path, ""), caller)
+			if body is not None and "subhandler(" in body:
+				targets |= subhandlers(sources[path], known)
+		if targets:
+			calls[caller] |= targets
+		else:
+			unresolved.add(caller)
+	return unresolved
+
+def handlerNames():
+	source = open(HANDLERS_FILE).read()
+	body = source[source.index("lookupHandler("):]
+	body = body[:body.index("\n}\n")]
+	return HANDLER_CASE_RE.findall(body)
+
+class StackGraph:
+	def __init__(self, frames, calls):
+		self.frames = frames
+		self.calls = calls
+		self.memo = {}
+		self.recursive = set()
+
+	# returns (depth, chain) of the deepest chain starting in function
+	def deepest(self, function, active=()):
+		if function in self.memo:
+			return self.memo[function]
+		if function in active:
+			self.recursive.add(function)
+			return (0, [function + " (recursion)"])
+		bestDepth, bestChain = 0, []
+		for callee in sorted(self.calls.get(function, ())):
+			depth, chain = self.deepest(callee, active + (function,))
+			if depth > bestDepth:
+				bestDepth, bestChain = depth, chain
+		result = (self.frames.get(function, 0) + bestDepth, [function] + bestChain)
+		self.memo[function] = result
+		return result
+
+def stackBudget(nm, elfFile):
+	symbols = {}
+	output = subprocess.run([nm, elfFile], capture_output=True, text=True, check=True).stdout
+	for line in output.splitlines():
+		fields = line.split()
+		if len(fields) == 3:
+			symbols[fields[2]] = int(fields[0], 16)
+	if "app_stack_canary" not in symbols or "_estack" not in symbols:
+		sys.exit("no stack symbols in " + elfFile + ", pass --budget")
+	return symbols["_estack"] - symbols["app_stack_canary"]
+
+def main():
+	parser = argparse.ArgumentParser()
+	parser.add_argument("--budget", type=int)
+	parser.add_argument("--nm", default="nm")
+	parser.add_argument("--elf", default="bin/app.elf")
+	parser.add_argument("--top", type=int, default=3)
+	parser.add_argument("objdump")
+	parser.add_argument("objdir")
+	args = parser.parse_args()
+
+	frames, files, dynamic = parseStackUsage(args.objdir)
+	calls, indirect = parseCallGraph(args.objdump)
+	unresolved = resolveIndirectCalls(calls, indirect, files)
+	graph = StackGraph(frames, calls)
+
+	dispatch = sum(frames.get(f, 0) for f in DISPATCH_CHAIN)
+	budget = args.budget if args.budget is not None else stackBudget(args.nm, args.elf)
+	handlers = [handler for handler in handlerNames() if handler in calls]
+
+	# what handleApdu calls besides the handler, e.g. when an instruction starts
+	dispatchCallees = calls.get(DISPATCH_FUNCTION, set()) - set(handlers)
+	dispatchCalleeDepth, dispatchCalleeChain = max(
+	        (graph.deepest(callee) for callee in sorted(dispatchCallees)), default=(0, [])
+	)
+
+	eventDepth, _ = graph.deepest(EVENT_HANDLER)
+	event = sum(frames.get(f, 0) for f in EVENT_CHAIN) + eventDepth + frames.get(UI_CALLBACK, 0)
+
+	print(f"stack budget {budget} bytes, APDU dispatch {dispatch} bytes, UI event dispatch {event} bytes")
+	results = []
+	for handler in handlers:
+		depth, chain = graph.deepest(handler)
+		if dispatchCalleeDepth > depth:
+			depth, chain = dispatchCalleeDepth, dispatchCalleeChain
+		results.append((dispatch + depth, handler, chain))
+	for step in sorted(f for f in calls if UI_STEP_RE.search(f)):
+		depth, chain = graph.deepest(step)
+		results.append((event + depth, step + " (from " + EVENT_HANDLER + ")", chain))
+	results.sort(reverse=True)
+
+	for total, handler, chain in results:
+		print(f"{total:6d}  {handler}")
+	for total, handler, chain in results[:args.top]:
+		print(f"\ndeepest chain of {handler}, {total} bytes:")
+		for function in chain:
+			name = function.split(" ")[0]
+			notes = []
+			if name not in frames:
+				notes.append("no stack usage info")
+			if name in dynamic:
+				notes.append("dynamic")
+			if name in unresolved:
+				notes.append("unresolved indirect call")
+			suffix = f" ({', '.join(notes)})" if notes else ""
+			print(f"  {frames.get(name, 0):6d}  {function}{suffix}")
+
+	for function in sorted(graph.recursive):
+		print(f"warning: recursion through {function}")
+	for function in sorted(unresolved & set(graph.memo)):
+		print(f"warning: unresolved indirect call in {function}")
+
+	worst = results[0][0] if results else 0
+	if worst > budget:
+		print(f"error: {results[0][1]} needs {worst} bytes of stack, budget is {budget}")
+		sys.exit(1)
+	print(f"\nheadroom {budget - worst} bytes")
+
+main()